@@ -5,16 +5,29 @@
 *				3. Struct Methods	- methods to create, modify or search struct arrays
 *				4. Main Array		- main engine of this program. Search array, find options, backtracking.
 *				5. Main Functions	- main functions, that combine all of the above
-*				6. Main				- main body of this program
+*				6. Session			- keeps solver state between edits of clues, recomputes only elements around edited field
+*				7. Generator		- generates random puzzles with only one solution on all cores
+*				8. Binary Format	- compact binary streams of puzzles and solutions with index, converters from and to ASCII
+*				9. Enumeration		- streams every solution of puzzle into compact binary stream
+*				10. Cube And Conquer	- splits search into subproblem files, solves them independently and merges results
+*				11. Portfolio		- solves puzzle with different branching heuristics on threads, the fastest one wins
+*				12. Main			- main body of this program
 *
 *	Author: Jakub Novak
 *	Nov-2020
 */
 
 
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <math.h>
+#include <limits.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
 
 /* max possible characters of one line of 32x32 field */
 #define MAX_NUMBER_OF_CHARS 97
@@ -22,6 +35,42 @@
 #define BASIC_NUMBER_OF_OPTIONS 20
 #define PREPROCESSOR_ID -1
 #define ID_MULTIPLIER 500
+/* maximum side of rectangle in random partition of generator */
+#define GENERATOR_MAX_SIDE 8
+/* maximum area of rectangle of generator */
+#define GENERATOR_MAX_AREA 24
+/* number of placed options, after which uniqueness check of generator gives up */
+#define GENERATOR_MAX_NODES 5000
+/* number of attempts to move clues, before candidate of generator is thrown away */
+#define GENERATOR_RELOCATIONS 10
+/* binary format, described in section BINARY FORMAT */
+#define BINARY_VERSION 2
+#define BINARY_HEADER_SIZE 8
+#define INDEX_HEADER_SIZE 16
+#define PUZZLE_MAGIC "SHKP"
+#define SOLUTION_MAGIC "SHKS"
+#define INDEX_MAGIC "SHKI"
+#define ENUMERATION_MAGIC "SHKE"
+#define CUBE_MAGIC "SHKC"
+#define MAX_PUZZLE_RECORD_SIZE (4 + 3 * MAX_NUMBER_OF_ELEMENTS)
+#define MAX_SOLUTION_RECORD_SIZE (17 + 6 * MAX_NUMBER_OF_ELEMENTS)
+#define BINARY_NO_SOLUTION 0
+#define BINARY_ONE_SOLUTION 1
+#define BINARY_MORE_SOLUTIONS 2
+#define BINARY_WRONG_INPUT 3
+/* size of bounded buffer of enumeration output */
+#define OUTPUT_BUFFER_SIZE 65536
+/* number of placed options between two checks, if search was cancelled */
+#define CANCEL_CHECK_INTERVAL 1024
+/* limit of placed options of the first run of randomized heuristic, doubled after every restart */
+#define PORTFOLIO_FIRST_RESTART 1000
+/* branching heuristics */
+#define HEURISTIC_DEFAULT 0
+#define HEURISTIC_FEWEST_OPTIONS 1
+#define HEURISTIC_LARGEST_VALUE 2
+#define HEURISTIC_MOST_CONFLICTS 3
+#define HEURISTIC_RANDOM 4
+#define NUMBER_OF_HEURISTICS 5
 
 /*-----------------------------------------STRUCTS-----------------------------------------*/
 
@@ -33,6 +82,9 @@ typedef struct{
 									/* Unique number.	id / ID_MULTIPLIER - 1 represents position of element in array */
 									/* 					id % ID_MULTIPLIER - 1 represents position of option in array */
 	char * arrayOfIndexes;			/* arrays containing indexes of main array, where it will be filled. {x1,y1,x2,y2,x3,y3...} */
+	char top;						/* first row of rectangle of this option */
+	char bottom;					/* last row of rectangle of this option */
+	unsigned int colMask;			/* bit n is set, if rectangle covers column n. Together with rows it is whole footprint of option */
 	char inUse;						/* says, if this option is being used right now for determination */
 	char implacable;				/* says if this option is not possible to be placed right now */
 	int implacedBy;					/* Id of the one, who implaced it, -1 for preprocessor */
@@ -57,20 +109,147 @@ typedef struct{
 	Option * options;				/* Object containing all possible fillings of fields for one element */
 }Element;
 
+/*
+*SearchControl struct. Limits of one run of recursive backtracking
+*/
+typedef struct{
+	long long maxResults;				/* search stops, when number of results reaches this number, 0 for no limit */
+	long long maxNodes;					/* search stops, when number of placed options reaches this number, 0 for no limit */
+	long long nodes;					/* number of placed options */
+	void (*onResult)(void * data, Element * elements, int options[], int numberOfOptions, long long result);	/* called for every result, can be NULL */
+	int maxDepth;						/* number of decisions, after which branch is passed to onFrontier instead of searched, 0 for no limit */
+	void (*onFrontier)(void * data, Element * elements, int options[], int numberOfOptions);	/* called for every open branch at maxDepth */
+	void * data;						/* data passed to onResult and onFrontier */
+	int startSpot;						/* spot of first decision, set by sessionSearch */
+	int heuristic;						/* branching heuristic (HEURISTIC_*), options are tried in random order for HEURISTIC_RANDOM */
+	unsigned long long randomState;		/* state of random generator of HEURISTIC_RANDOM, must not be 0 */
+	int (*cancelled)(void * data);		/* checked every CANCEL_CHECK_INTERVAL placed options, search stops, if it returns 1. Can be NULL */
+}SearchControl;
+
+/*
+*Session struct. Keeps solver state between edits of clues, so only options and collisions of elements
+*around edited field have to be recomputed. Collisions in implacesArr of options are complete and symmetric.
+*/
+typedef struct{
+	unsigned char clueArray[32][32];	/* values of clues, 0 for empty field */
+	int numberOfRows;
+	int numberOfCols;
+	int totalNumbers;
+	Element * elements;					/* array with capacity of MAX_NUMBER_OF_ELEMENTS, element on index i has id i + 1 */
+	char boxArr[MAX_NUMBER_OF_ELEMENTS][4];	/* bounding box of all options of element {top,left,bottom,right} */
+}Session;
+
+/*
+*Rectangle struct. One rectangle of partition (of generator or of solution in binary format) and its clue
+*/
+typedef struct{
+	unsigned char top;
+	unsigned char left;
+	unsigned char bottom;
+	unsigned char right;
+	unsigned char row;					/* row of clue */
+	unsigned char col;					/* col of clue */
+}Rectangle;
+
+/*
+*Generator struct. Shared state of all threads of generator
+*/
+typedef struct{
+	int numberOfRows;
+	int numberOfCols;
+	int count;							/* number of puzzles to generate */
+	int produced;						/* number of already printed puzzles */
+	long long candidates;				/* number of tested random partitions */
+	pthread_mutex_t mutex;				/* guards produced, candidates and printing */
+}Generator;
+
+/*
+*BinaryWriter struct. Binary stream of records with its index
+*/
+typedef struct{
+	FILE * stream;
+	FILE * index;						/* NULL, if stream is stdout */
+	unsigned long long position;		/* offset of next record from the beginning of stream */
+	unsigned long long numberOfRecords;
+}BinaryWriter;
+
+/*
+*OutputBuffer struct. Bounded buffer for output, that is written by one fwrite, when it is full
+*/
+typedef struct{
+	FILE * stream;
+	int length;
+	unsigned char data[OUTPUT_BUFFER_SIZE];
+}OutputBuffer;
+
+/*
+*Enumeration struct. State of streaming of all solutions
+*/
+typedef struct{
+	OutputBuffer * output;
+	long long offset;					/* number of solutions skipped at the beginning */
+	long long written;					/* number of written solutions */
+}Enumeration;
+
+/*
+*Splitter struct. State of split mode, that writes open branches of search into cube files
+*/
+typedef struct{
+	Session * session;
+	const char * directory;				/* NULL, if branches are only counted */
+	int numberOfCubes;
+	int failed;							/* some cube file could not be written */
+}Splitter;
+
+/*
+*Portfolio struct. Shared state of threads, that solve the same puzzle with different heuristics
+*/
+typedef struct{
+	unsigned char clueArray[32][32];
+	int numberOfRows;
+	int numberOfCols;
+	int totalNumbers;
+	int query;							/* 1 asks, if solution exists, 2 asks, if it is unique */
+	int winner;							/* index of thread, that settled the query first, -1 until then */
+	pthread_mutex_t mutex;
+}Portfolio;
+
+/*
+*PortfolioWorker struct. One thread of portfolio with its own copy of solver state
+*/
+typedef struct{
+	Portfolio * portfolio;
+	int index;
+	int heuristic;
+	Session session;
+	unsigned char resultArray[32][32];
+	int results;						/* number of results, at most query */
+	long long nodes;					/* placed options of all runs */
+	int restarts;
+}PortfolioWorker;
+
+/*
+*GeneratorWorker struct. State of one thread of generator
+*/
+typedef struct{
+	Generator * generator;
+	unsigned long long randomState;
+}GeneratorWorker;
+
 /*-----------------------------------------INPUT & OUTPUT-----------------------------------------*/
 
 /*
 *Read first or last row, which is only represented by - and +, check for errors and if ok, 
 *compute number of cols for first line, which will serve as comparator for other rows
 */
-int readTopAndBottomLine(int * numberOfCols){
+int readTopAndBottomLine(FILE * stream, int * numberOfCols){
 	
 	int numberOfColsChars, c;
 	/* this is needed to make difference between top and bottom line */
 	/* bottom line already starts from char 3, because first two chars have already been read in readInput() */
 	numberOfColsChars = *numberOfCols > 0 ? 2 : 0;
 	/* reading input */
-	while ((c = getc(stdin)) != '\n'){
+	while ((c = getc(stream)) != '\n'){
 		if (numberOfColsChars % 3 == 0 && c != '+') return 0;
 		else if (numberOfColsChars % 3 != 0 && c != '-') return 0;
 		numberOfColsChars++;
@@ -94,10 +273,10 @@ int readTopAndBottomLine(int * numberOfCols){
 *Read rows, that contain fields. Checks for right format.
 *Assign values in fields into main array. Empty fields are interpreted into 0
 */
-int readRow(unsigned char mainArray[][32], int numberOfRows, int numberOfCols, int * totalNumbers){
+int readRow(FILE * stream, unsigned char mainArray[][32], int numberOfRows, int numberOfCols, int * totalNumbers){
 
 	char counter = 1, c;
-	while ((c = getc(stdin)) != '|'){
+	while ((c = getc(stream)) != '|'){
 		/* Handle ' ' between fields */
 		if (counter > 1 && counter % 3 == 0 && c != ' ') return 0;
 		else if (counter > 1 && counter % 3 == 0 && c == ' '){
@@ -111,7 +290,7 @@ int readRow(unsigned char mainArray[][32], int numberOfRows, int numberOfCols, i
 		if ( c >= 49 && c <= 57) num = (c - 48) * 10;
 		else if ( c != ' ' ) return 0; 
 		/* read next char, because we are still in one field, that may contain numbers */
-		c = getc(stdin);
+		c = getc(stream);
 		if ( c >= 49 && c <= 57) num += (c - 48);
 		else if ( c == '0' && num == 0) return 0;
 		else if ( c != ' ' && c != '0') return 0; 
@@ -129,7 +308,7 @@ int readRow(unsigned char mainArray[][32], int numberOfRows, int numberOfCols, i
 	/* check if length is same as first row */
 	if (numberOfCols != (counter) / 3) return 0;
 	/* after '|' must always be '\n' */
-	if ((c = getc(stdin)) != '\n') return 0;
+	if ((c = getc(stream)) != '\n') return 0;
 	return 1;
 }
 
@@ -137,11 +316,11 @@ int readRow(unsigned char mainArray[][32], int numberOfRows, int numberOfCols, i
 *Read only rows, that are between fields, checks if they are given in right format.
 *Returns 1, if all ok, 0 if wrong
 */
-int readSemiRow(int numberOfCols){
+int readSemiRow(FILE * stream, int numberOfCols){
 	/* numberOfColsChars has to start from 2, because first two chars have already been read in readInput() */
 	int numberOfColsChars = 2, c;
 	/* check for right format */
-	while ((c = getc(stdin)) != '\n'){
+	while ((c = getc(stream)) != '\n'){
 		if (numberOfColsChars % 3 == 0 && c != '+') return 0;
 		else if (numberOfColsChars % 3 != 0 && c != ' ') return 0;
 		numberOfColsChars++;
@@ -157,16 +336,16 @@ int readSemiRow(int numberOfCols){
 *Read whole input. Check, if it is in right format.
 *Assign to array only numbers and empty fields (represented by 0)
 */
-int readInput(unsigned char mainArray[][32], int * numberOfRows, int * numberOfCols, int * totalNumbers){
+int readInput(FILE * stream, unsigned char mainArray[][32], int * numberOfRows, int * numberOfCols, int * totalNumbers){
 	
 	char c;
 	int bottomLineRead = 0;
 	int counter = 0;
 	int semiCounter = 0;
 	/* read top line */
-	if (!readTopAndBottomLine(numberOfCols) || * numberOfCols == 0 || * numberOfCols > 32) return 0;
+	if (!readTopAndBottomLine(stream, numberOfCols) || * numberOfCols == 0 || * numberOfCols > 32) return 0;
 	/* keep reading while line starts with either '|' or '+' */
-	while ((c = getc(stdin)) == '|' || c == '+'){
+	while ((c = getc(stream)) == '|' || c == '+'){
 		if(bottomLineRead) return 0;
 		counter++;
 		/* read rows with fields */
@@ -174,26 +353,26 @@ int readInput(unsigned char mainArray[][32], int * numberOfRows, int * numberOfC
 			/* For missing semilines */
 			if (counter % 2 == 0) return 0;
 			/* read one row */
-			if (readRow(mainArray, *numberOfRows, *numberOfCols, totalNumbers)) (*numberOfRows)++;
+			if (readRow(stream, mainArray, *numberOfRows, *numberOfCols, totalNumbers)) (*numberOfRows)++;
 			else return 0;
 			if (*numberOfRows > 32) return 0;
 		}else{
 			/* if c is '+', check for next char */
-			c = getc(stdin);
+			c = getc(stream);
 			if (c == ' '){
 				/* read semi row */
 				semiCounter++;
 				if (counter % 2 != 0) return 0;
-				if (!readSemiRow(*numberOfCols)) return 0;
+				if (!readSemiRow(stream, *numberOfCols)) return 0;
 			} else if (c == '-'){
 				/* read bottom line */
 				bottomLineRead = 1;
-				if (!readTopAndBottomLine(numberOfCols)) return 0;
+				if (!readTopAndBottomLine(stream, numberOfCols)) return 0;
 			}else return 0;
 		}
 	}
 	/* check if all given conditions are met */
-	if (*totalNumbers > 200 || *totalNumbers == 0 || !feof(stdin) || !bottomLineRead
+	if (*totalNumbers > 200 || *totalNumbers == 0 || !feof(stream) || !bottomLineRead
 	|| *numberOfRows > 32 || *numberOfCols > 32 || *numberOfRows == 0 || *numberOfCols == 0 || (semiCounter + 1 != *numberOfRows)) return 0;
 
 	return 1;
@@ -245,12 +424,11 @@ void printLine(unsigned char mainArray[][32], Element * elements, int totalNumbe
 }
 
 /*
-*Print result table for one and only possible solution
+*Print table of solution without any title
 */
-void printResult(unsigned char mainArray[][32], Element * elements, int totalNumbers, int numberOfRows, int numberOfCols){
+void printBoard(unsigned char mainArray[][32], Element * elements, int totalNumbers, int numberOfRows, int numberOfCols){
 	
 	unsigned char elementsArr[32][32];
-	printf("Jedno reseni:\n");
 	for (int i = 0; i < numberOfRows; i++)
 		for (int j = 0; j < numberOfCols; j++) elementsArr[i][j] = 0;
 	
@@ -265,8 +443,56 @@ void printResult(unsigned char mainArray[][32], Element * elements, int totalNum
 	printTopAndBottomLine(numberOfCols);
 }
 
+/*
+*Print result table for one and only possible solution
+*/
+void printResult(unsigned char mainArray[][32], Element * elements, int totalNumbers, int numberOfRows, int numberOfCols){
+	
+	printf("Jedno reseni:\n");
+	printBoard(mainArray, elements, totalNumbers, numberOfRows, numberOfCols);
+}
+
+/*
+*Print puzzle in the same format, as is read by readInput
+*/
+void printPuzzle(unsigned char clueArray[][32], int numberOfRows, int numberOfCols){
+
+	printTopAndBottomLine(numberOfCols);
+	for (int i = 0; i < numberOfRows; i++){
+		printf("|");
+		for (int j = 0; j < numberOfCols; j++){
+			if (clueArray[i][j] != 0) printf("%2d", clueArray[i][j]);
+			else printf("  ");
+			printf(j < numberOfCols - 1 ? " " : "|\n");
+		}
+		if (i < numberOfRows - 1){
+			printf("+");
+			for (int j = 0; j < numberOfCols; j++) printf("  +");
+			printf("\n");
+		}
+	}
+	printTopAndBottomLine(numberOfCols);
+}
+
 /*-----------------------------------------STRUCT METHODS-----------------------------------------*/
 
+/*
+*Sets default values of one element and allocates its array of options
+*/
+void initElement(Element * element, int id, int row, int col, int value){
+
+	element->id = id;
+	element->value = value;
+	element->row = row;
+	element->col = col;
+	element->numberOfOptions = 0;
+	element->options = (Option*) malloc(BASIC_NUMBER_OF_OPTIONS * sizeof(*element->options));
+	element->maxNumberOfOptions = BASIC_NUMBER_OF_OPTIONS;
+	element->numberOfImplacableOptions = 0;
+	element->inUse = 0;
+	element->mediumNumberOfImplaces = 0;
+}
+
 /*
 *Creates and returns an array of elements.
 */
@@ -278,17 +504,7 @@ Element * createStructuresFromElements(unsigned char mainArray[][32], int totalN
 	for (int i = 0; i < numberOfRows; i++){
 		for (int j = 0; j < numberOfCols; j++){
 			if (mainArray[i][j] > 0){
-				elements[count].id = count + 1;
-				elements[count].value = mainArray[i][j];
-				elements[count].row = i;
-				elements[count].col = j;
-				elements[count].numberOfOptions = 0;
-				Option * options = (Option*) malloc(BASIC_NUMBER_OF_OPTIONS * sizeof(*options));
-				elements[count].options = options;
-				elements[count].maxNumberOfOptions = BASIC_NUMBER_OF_OPTIONS;
-				elements[count].numberOfImplacableOptions = 0;
-				elements[count].inUse = 0;
-				elements[count].mediumNumberOfImplaces = 0;
+				initElement(&elements[count], count + 1, i, j, mainArray[i][j]);
 				count++;
 			}
 		}
@@ -296,6 +512,25 @@ Element * createStructuresFromElements(unsigned char mainArray[][32], int totalN
 	return elements;
 }
 
+/*
+*Returns next pseudo random number (xorshift). Every thread has its own state
+*/
+unsigned long long nextRandom(unsigned long long * state){
+
+	*state ^= *state << 13;
+	*state ^= *state >> 7;
+	*state ^= *state << 17;
+	return *state;
+}
+
+/*
+*Returns random number from interval <from, to>
+*/
+int randomInRange(unsigned long long * state, int from, int to){
+
+	return from + (int)(nextRandom(state) % (unsigned long long)(to - from + 1));
+}
+
 /*
 *Returns index of element, that has the biggest value with least options
 *Or -1. if all elements have been used or -2 if there is an element, that cannot be placed anymore
@@ -320,6 +555,41 @@ int findIndexOfBiggestNotInUseElement(Element * elements, int totalNumbers){
 	return index;
 }
 
+/*
+*Returns index of next element for branching by heuristic of control, default heuristic is used for NULL
+*Or -1. if all elements have been used or -2 if there is an element, that cannot be placed anymore
+*/
+int findIndexByHeuristic(Element * elements, int totalNumbers, SearchControl * control){
+
+	if (!control || control->heuristic == HEURISTIC_DEFAULT) return findIndexOfBiggestNotInUseElement(elements, totalNumbers);
+	int index = -1;
+	int topPoints = 0;
+	int points = 0;
+	int ties = 0;
+
+	for (int i = 0; i < totalNumbers; i++){
+		if (elements[i].inUse) continue;
+		int liveOptions = elements[i].numberOfOptions - elements[i].numberOfImplacableOptions;
+		if (liveOptions == 0) return -2;
+		if (control->heuristic == HEURISTIC_LARGEST_VALUE) points = elements[i].value * 100000 - liveOptions;
+		else if (control->heuristic == HEURISTIC_MOST_CONFLICTS){
+			/* average number of collisions of options, that can still be placed */
+			points = 0;
+			for (int j = 0; j < elements[i].numberOfOptions; j++) if (!elements[i].options[j].implacable) points += elements[i].options[j].numberOfImplaces;
+			points /= liveOptions;
+		}
+		else points = -liveOptions * 100 + (control->heuristic == HEURISTIC_FEWEST_OPTIONS ? elements[i].value : 0);
+		if (index == -1 || points > topPoints){
+			topPoints = points;
+			index = i;
+			ties = 1;
+		/* randomized heuristic chooses uniformly from elements with the same points */
+		} else if (control->heuristic == HEURISTIC_RANDOM && points == topPoints && randomInRange(&control->randomState, 0, ties++) == 0) index = i;
+	}
+
+	return index;
+}
+
 /*
 *Dynamically creates array of indexes for option of element.
 *These indexes represent indexes of mainArray in this format:
@@ -345,6 +615,14 @@ void createOptionForElement(Element * elements, int index, char coordsArr[], int
 	/* Assign all other properties of option */
 	elements[index].options[elements[index].numberOfOptions].id = elements[index].id * ID_MULTIPLIER + elements[index].numberOfOptions + 1; //Unique id, that is used for main search
 	elements[index].options[elements[index].numberOfOptions].arrayOfIndexes = arrayOfIndexes;
+	/* footprint of rectangle, element itself is its part too */
+	elements[index].options[elements[index].numberOfOptions].top = elements[index].options[elements[index].numberOfOptions].bottom = elements[index].row;
+	elements[index].options[elements[index].numberOfOptions].colMask = 0;
+	for (int i = 0; i < numberOfCoords + 2; i += 2){
+		if (arrayOfIndexes[i] < elements[index].options[elements[index].numberOfOptions].top) elements[index].options[elements[index].numberOfOptions].top = arrayOfIndexes[i];
+		if (arrayOfIndexes[i] > elements[index].options[elements[index].numberOfOptions].bottom) elements[index].options[elements[index].numberOfOptions].bottom = arrayOfIndexes[i];
+		elements[index].options[elements[index].numberOfOptions].colMask |= 1u << arrayOfIndexes[i + 1];
+	}
 	elements[index].options[elements[index].numberOfOptions].inUse = 0;
 	elements[index].options[elements[index].numberOfOptions].implacable = 0;
 	elements[index].options[elements[index].numberOfOptions].implacedBy = 0;	
@@ -355,10 +633,47 @@ void createOptionForElement(Element * elements, int index, char coordsArr[], int
 	
 }
 
+/*
+*Return 1, if rectangles of two options have at least one common field
+*/
+int optionsOverlap(Option * first, Option * second){
+
+	return first->top <= second->bottom && second->top <= first->bottom && (first->colMask & second->colMask) != 0;
+}
+
+/*
+*Returns mask of one completely filled row
+*/
+unsigned int fullRowMask(int numberOfCols){
+
+	return numberOfCols == 32 ? ~0u : (1u << numberOfCols) - 1;
+}
+
+/*
+*Adds footprint of option into masks of filled fields, one mask per row
+*/
+void addOptionToRowMasks(Option * option, unsigned int rowMasks[]){
+
+	for (int k = option->top; k <= option->bottom; k++) rowMasks[k] |= option->colMask;
+}
+
+/*
+*Return 1, if option of element covers some filled field of rowMasks. Field of element itself is excluded
+*/
+int optionCoversFilled(Option * option, Element * element, unsigned int rowMasks[]){
+
+	for (int k = option->top; k <= option->bottom; k++){
+		unsigned int filled = k == element->row ? rowMasks[k] & ~(1u << element->col) : rowMasks[k];
+		if (filled & option->colMask) return 1;
+	}
+	return 0;
+}
+
 /*
 *Find options for all elements, that cannot be placed in current layout and set them as implacable
+*For preprocessor, layout is given by rowMasks of filled fields. Otherwise it is footprint of caller option and rowMasks are not used
 */
-void findImplacableOptions(unsigned char mainArray[][32], Element * elements, int totalNumbers, int callerElementIndex, int callerOptionIndex){
+void findImplacableOptions(unsigned int rowMasks[], Element * elements, int totalNumbers, int callerElementIndex, int callerOptionIndex){
 	
 	int totalCount = 0;
 	int count = 0;
@@ -369,35 +684,27 @@ void findImplacableOptions(unsigned char mainArray[][32], Element * elements, in
 		count = 0;
 		for (int j = 0; j < elements[i].numberOfOptions; j++){
 			if (!elements[i].options[j].implacable && callerElementIndex == PREPROCESSOR_ID){
-				/* -2 because we need to exclude the element itself */
-				for (int k = 0; k < (elements[i].value * 2) - 2; k += 2){
-					if (mainArray[(int)elements[i].options[j].arrayOfIndexes[k]][(int)elements[i].options[j].arrayOfIndexes[k + 1]] != 0){
-						elements[i].options[j].implacable = 1;
-						elements[i].options[j].implacedBy = callerElementIndex;
-						elements[i].numberOfImplacableOptions += 1;
-						break;
-					}
+				if (optionCoversFilled(&elements[i].options[j], &elements[i], rowMasks)){
+					elements[i].options[j].implacable = 1;
+					elements[i].options[j].implacedBy = callerElementIndex;
+					elements[i].numberOfImplacableOptions += 1;
 				}
 			} else if (!elements[i].options[j].implacable){
-				/* -2 because we need to exclude the element itself */
-				for (int k = 0; k < (elements[i].value * 2) - 2; k += 2){
-					/* check for collisions */
-					if (mainArray[(int)elements[i].options[j].arrayOfIndexes[k]][(int)elements[i].options[j].arrayOfIndexes[k + 1]] != 0){
-						/* realloc if needed */
-						if (elements[callerElementIndex].options[callerOptionIndex].numberOfImplaces + 2 >= elements[callerElementIndex].options[callerOptionIndex].maxNumberOfImplaces){
-							elements[callerElementIndex].options[callerOptionIndex].maxNumberOfImplaces *= 2;
-							int * tmp = (int*) realloc(elements[callerElementIndex].options[callerOptionIndex].implacesArr ,elements[callerElementIndex].options[callerOptionIndex].maxNumberOfImplaces * sizeof(*tmp));
-							elements[callerElementIndex].options[callerOptionIndex].implacesArr = tmp;
-						}
-						/* insert element index and option index of implaced option into array */
-						elements[callerElementIndex].options[callerOptionIndex].implacesArr[elements[callerElementIndex].options[callerOptionIndex].numberOfImplaces] = i;
-						elements[callerElementIndex].options[callerOptionIndex].implacesArr[elements[callerElementIndex].options[callerOptionIndex].numberOfImplaces + 1] = j;
-						elements[callerElementIndex].options[callerOptionIndex].numberOfImplaces += 2;
-						count++;
-						totalCount++;
-						elements[callerElementIndex].mediumNumberOfImplaces++;
-						break;
+				/* check for collision, options never cover other elements, so whole rectangles can be compared */
+				if (optionsOverlap(&elements[callerElementIndex].options[callerOptionIndex], &elements[i].options[j])){
+					/* realloc if needed */
+					if (elements[callerElementIndex].options[callerOptionIndex].numberOfImplaces + 2 >= elements[callerElementIndex].options[callerOptionIndex].maxNumberOfImplaces){
+						elements[callerElementIndex].options[callerOptionIndex].maxNumberOfImplaces *= 2;
+						int * tmp = (int*) realloc(elements[callerElementIndex].options[callerOptionIndex].implacesArr ,elements[callerElementIndex].options[callerOptionIndex].maxNumberOfImplaces * sizeof(*tmp));
+						elements[callerElementIndex].options[callerOptionIndex].implacesArr = tmp;
 					}
+					/* insert element index and option index of implaced option into array */
+					elements[callerElementIndex].options[callerOptionIndex].implacesArr[elements[callerElementIndex].options[callerOptionIndex].numberOfImplaces] = i;
+					elements[callerElementIndex].options[callerOptionIndex].implacesArr[elements[callerElementIndex].options[callerOptionIndex].numberOfImplaces + 1] = j;
+					elements[callerElementIndex].options[callerOptionIndex].numberOfImplaces += 2;
+					count++;
+					totalCount++;
+					elements[callerElementIndex].mediumNumberOfImplaces++;
 				}
 			}
 			
@@ -415,23 +722,16 @@ void findImplacableOptions(unsigned char mainArray[][32], Element * elements, in
 }
 
 /*
-*Fill temporary array with each option of each element and try to combine it with
-*each option of each element and find collisions
+*Try to combine each option of each element with each option of each element and find collisions
+*Placeable options dont cover filled fields, so only footprints of options are compared
 */
-void fillImplacableArrays(unsigned char mainArray[][32], Element * elements, int totalNumbers, int numberOfRows, int numberOfCols){
+void fillImplacableArrays(Element * elements, int totalNumbers){
 	
-	unsigned char tmpArr[32][32];
-		
 	for (int i = 0; i < totalNumbers; i++) {
 		if (elements[i].inUse) continue;
 		for (int j = 0; j < elements[i].numberOfOptions; j++){
 			if (elements[i].options[j].implacable == 1) continue;
-			for (int k = 0; k < numberOfRows; k++)
-				for (int l = 0; l < numberOfCols; l++) tmpArr[k][l] = mainArray[k][l];
-					
-			for (int k = 0; k < elements[i].value * 2; k+=2) tmpArr[(int)elements[i].options[j].arrayOfIndexes[k]][(int)elements[i].options[j].arrayOfIndexes[k + 1]] = 1;
-				
-			findImplacableOptions(tmpArr, elements, totalNumbers, i, j);
+			findImplacableOptions(NULL, elements, totalNumbers, i, j);
 		}
 		elements[i].mediumNumberOfImplaces /= (elements[i].numberOfOptions * 10);
 	}
@@ -550,6 +850,29 @@ void computeOptionsForElement(unsigned char mainArray[][32], Element * elements,
 	}
 }
 
+/*
+*Finds all options of placement for one element.
+*Uses computeOptionsForElement for every rectangle, which has area of element value
+*/
+void findOptionsForElement(unsigned char mainArray[][32], Element * elements, int index, int numberOfCols, int numberOfRows){
+
+	elements[index].numberOfOptions = 0;
+	int value = elements[index].value;
+	int division = 0;
+	for (int divider = (int)floor(sqrt(value)); divider > 0; divider--){
+		/* exclude non rectangle objects */
+		if (value % divider != 0) continue;
+		division = value / divider;
+		/* method to compute number of options for element */
+		computeOptionsForElement(mainArray, elements, index, numberOfCols, numberOfRows, division, divider);
+		/* if value is perfect power, we cannot continue with next method, because some results would be doubled */
+		if (divider * divider == value) continue;
+		/* invert rows and cols */
+		/* compute more options for inverted rows and cols */
+		computeOptionsForElement(mainArray, elements, index, numberOfCols, numberOfRows, divider, division);
+	}
+}
+
 /*
 *Finds all options of placement for all elements.
 *Uses findOptions method to compute options and assign coordinates
@@ -557,33 +880,16 @@ void computeOptionsForElement(unsigned char mainArray[][32], Element * elements,
 */
 void findAllOptionsForElements(unsigned char mainArray[][32], Element * elements, int totalNumbers, int numberOfCols, int numberOfRows){
 	
-	for (int i = 0; i < totalNumbers; i++){
-		elements[i].numberOfOptions = 0;
-		int value = elements[i].value;
-		int division = 0;
-		for (int divider = (int)floor(sqrt(value)); divider > 0; divider--){
-			/* exclude non rectangle objects */
-			if (value % divider != 0) continue;
-			division = value / divider;
-			/* method to compute number of options for element */
-			computeOptionsForElement(mainArray, elements, i, numberOfCols, numberOfRows, division, divider);
-			/* if value is perfect power, we cannot continue with next method, because some results would be doubled */
-			if (divider * divider == value) continue;
-			/* invert rows and cols */
-			/* compute more options for inverted rows and cols */
-			computeOptionsForElement(mainArray, elements, i, numberOfCols, numberOfRows, divider, division);	
-			/* return inverted rows and cols back to their original values, so we dont end up in infinite loop */
-
-		}
-	}
+	for (int i = 0; i < totalNumbers; i++) findOptionsForElement(mainArray, elements, i, numberOfCols, numberOfRows);
 }
 
 /*
 *Fills main array with id numbers of elements, that have only one possible option of placement
+*rowMasks hold filled fields of main array (one bit for every field) and are updated too
 *Return 1, if some element was found, 0 if not
 *Also checks, if some inly option overlays another only option. If so, noPossibleSolution is assigned true
 */
-int fillArrayWithOnlyOnePossibleOptions(unsigned char mainArray[][32], Element * elements, int totalNumbers, int * noPossibleSolution, int * alreadyComplete){
+int fillArrayWithOnlyOnePossibleOptions(unsigned char mainArray[][32], unsigned int rowMasks[], Element * elements, int totalNumbers, int * noPossibleSolution, int * alreadyComplete){
 	
 	int foundAndFilled = 0;
 	for (int i = 0; i < totalNumbers; i++){
@@ -593,62 +899,49 @@ int fillArrayWithOnlyOnePossibleOptions(unsigned char mainArray[][32], Element *
 			for (int k = 0; k < elements[i].numberOfOptions; k++) if (elements[i].options[k].implacable == 0) { index = k; elements[i].inUse = 1; break;}
 			foundAndFilled = 1;
 			(*alreadyComplete)++;
-			for (int j = 0; j < elements[i].value * 2; j += 2){
-				/* Check for overlay, assign noPossibleSolution if true and return 0*/
-				/* -2 because we need to exclude last two indexes of array, which are reserved for element itself */
-				if ( (j < (elements[i].value * 2) - 2) && mainArray[(int)elements[i].options[index].arrayOfIndexes[j]][(int)elements[i].options[index].arrayOfIndexes[j+1]] != 0){
-					*noPossibleSolution = 1;
-					return 0;
-				}
-				mainArray[(int)elements[i].options[index].arrayOfIndexes[j]][(int)elements[i].options[index].arrayOfIndexes[j+1]] = elements[i].id;
+			Option * option = &elements[i].options[index];
+			/* Check for overlay, assign noPossibleSolution if true and return 0*/
+			if (optionCoversFilled(option, &elements[i], rowMasks)){
+				*noPossibleSolution = 1;
+				return 0;
 			}
+			addOptionToRowMasks(option, rowMasks);
+			for (int j = 0; j < elements[i].value * 2; j += 2) mainArray[(int)option->arrayOfIndexes[j]][(int)option->arrayOfIndexes[j+1]] = elements[i].id;
 		} else if (elements[i].numberOfOptions - elements[i].numberOfImplacableOptions == 0 && elements[i].inUse == 0) { *noPossibleSolution = 1; return 0; }
 	}
 	return foundAndFilled;
 }
 
 /*
-*Check if whole field is filled. If so, return 1, if not, return 0
+*Check if whole field is filled by masks of its rows. If so, return 1, if not, return 0
 */
-int wholeFieldFilled(unsigned char mainArray[][32], int numberOfRows, int numberOfCols){
+int wholeFieldFilled(unsigned int rowMasks[], int numberOfRows, int numberOfCols){
 	
+	unsigned int fullMask = fullRowMask(numberOfCols);
 	for (int i = 0; i < numberOfRows; i++)
-		for (int j = 0; j < numberOfCols; j++) if (mainArray[i][j] == 0) return 0;
+		if (rowMasks[i] != fullMask) return 0;
 		
 	return 1;
 }
 
-/*
-*Combine all options of all elements into one array. Than check for empty spaces
-*Return 1, if there is a free spot, else return 0
-*DEPRACATED
-*/
-int emptyAfterAllOptionsOfAllElements(unsigned char mainArray[][32], Element * elements, int totalNumbers, int numberOfRows, int numberOfCols){
-	
-	unsigned char tmpArr[32][32];
-	
-	for (int i = 0; i < numberOfRows; i++)
-		for (int j = 0; j < numberOfCols; j++) tmpArr[i][j] = mainArray[i][j];
-		
-	for (int i = 0; i < totalNumbers; i++)
-		for (int j = 0; j < elements[i].numberOfOptions; j++)
-			for (int k = 0; k < elements[i].value * 2; k += 2)	tmpArr[(int)elements[i].options[j].arrayOfIndexes[k]][(int)elements[i].options[j].arrayOfIndexes[k + 1]] = 1;
-
-	return !wholeFieldFilled(tmpArr, numberOfRows, numberOfCols);
-}
-
 /*
 *Support function for compute results function. Copies main array into result array
-*and adds correct options of all elements into it
+*and adds correct options of all elements into it. rowMasks are set to filled fields of result array
 */
-void fillResultArray(unsigned char mainArray[][32], int totalNumbers, int numberOfRows, int numberOfCols, int result[], int alreadyComplete, Element * elements, unsigned char resultArray[][32]){
+void fillResultArray(unsigned char mainArray[][32], int totalNumbers, int numberOfRows, int numberOfCols, int result[], int alreadyComplete, Element * elements, unsigned char resultArray[][32], unsigned int rowMasks[]){
 	/* Copy array */
-	for (int k = 0; k < numberOfRows; k++)
-		for (int l = 0; l < numberOfCols; l++) resultArray[k][l] = mainArray[k][l];
+	for (int k = 0; k < numberOfRows; k++){
+		rowMasks[k] = 0;
+		for (int l = 0; l < numberOfCols; l++){
+			resultArray[k][l] = mainArray[k][l];
+			if (mainArray[k][l] != 0) rowMasks[k] |= 1u << l;
+		}
+	}
 	/* Assign correct options into result array */
 	for (int i = 0; i < totalNumbers - alreadyComplete; i++){
 		int elIndex = result[i] / ID_MULTIPLIER - 1;
 		int opIndex = result[i] % ID_MULTIPLIER - 1;
+		addOptionToRowMasks(&elements[elIndex].options[opIndex], rowMasks);
 		for (int j = 0; j < elements[elIndex].value * 2; j += 2) resultArray[(int)elements[elIndex].options[opIndex].arrayOfIndexes[j]][(int)elements[elIndex].options[opIndex].arrayOfIndexes[j+1]] = elements[elIndex].id;
 	}
 
@@ -667,24 +960,27 @@ void fillResultArray(unsigned char mainArray[][32], int totalNumbers, int number
 */
 int preProcessing(unsigned char mainArray[][32], Element * elements, int numberOfRows, int numberOfCols, int totalNumbers, int * noPossibleSolution, int * alreadyComplete){
 	
+	/* One mask of filled fields per row, at first only elements are there */
+	unsigned int rowMasks[32] = {0};
+	for (int i = 0; i < totalNumbers; i++) rowMasks[(int)elements[i].row] |= 1u << elements[i].col;
 	/* Find all possible placements for all elements */
 	findAllOptionsForElements(mainArray, elements, totalNumbers, numberOfCols, numberOfRows);
 	/* If there is an element with only one way of placement, fill these indexes of the main array with id of that element */
 	/* Than search options of all possible elements and remove options, that are no longer possible */
 	/* Repeat, until there are no elements with only one possible placement */
-	while (fillArrayWithOnlyOnePossibleOptions(mainArray, elements, totalNumbers, noPossibleSolution, alreadyComplete)){
-		findImplacableOptions(mainArray, elements, totalNumbers, PREPROCESSOR_ID, PREPROCESSOR_ID);
+	while (fillArrayWithOnlyOnePossibleOptions(mainArray, rowMasks, elements, totalNumbers, noPossibleSolution, alreadyComplete)){
+		findImplacableOptions(rowMasks, elements, totalNumbers, PREPROCESSOR_ID, PREPROCESSOR_ID);
 	}
 	/* Check, if some element is now unable to be placed. If so, puzzle doesnt have a solution */
 	for (int i = 0; i < totalNumbers; i++) if (elements[i].numberOfOptions - elements[i].numberOfImplacableOptions == 0) *noPossibleSolution = 1;
 	/* End program, if there is no possible solution */
-	if (*noPossibleSolution || ( allElementsComplete(elements, totalNumbers) && !wholeFieldFilled(mainArray, numberOfRows, numberOfCols)) ){
+	if (*noPossibleSolution || ( allElementsComplete(elements, totalNumbers) && !wholeFieldFilled(rowMasks, numberOfRows, numberOfCols)) ){
 		printf("Reseni neexistuje.\n");
 		return 0;
 	}
 	/* Check if whole field is filled. If so, there is only one solution */
 	/* Print that solution and quit */
-	if (wholeFieldFilled(mainArray, numberOfRows, numberOfCols)){
+	if (wholeFieldFilled(rowMasks, numberOfRows, numberOfCols)){
 		printResult(mainArray, elements, totalNumbers, numberOfRows, numberOfCols);
 		return 1;
 	}	
@@ -696,9 +992,10 @@ int preProcessing(unsigned char mainArray[][32], Element * elements, int numberO
 *Main engine of this program. Use backtracking to find all possible solutions
 *Variable result will hold number of results. Variable resultArr holds array with last result
 *Uses recursive backtracking algorithm
-*Returns 0, if no solution is possible (to save time) or 1, signaling, we can continue computing
+*Search stops, when some limit of control is reached (control can be NULL for no limits)
+*Returns 0, if no solution is possible (to save time) or limit was reached, 1, signaling, we can continue computing
 */
-int computeResults(unsigned char mainArray[][32], Element * elements, int totalNumbers, int elementIndex, int * results, int options[], short spot, unsigned char resultArray[][32], int numberOfRows, int numberOfCols, int alreadyComplete){
+int computeResults(unsigned char mainArray[][32], Element * elements, int totalNumbers, int elementIndex, long long * results, int options[], short spot, unsigned char resultArray[][32], int numberOfRows, int numberOfCols, int alreadyComplete, SearchControl * control){
 	/* MArk this element as in use, so it cant be used in next recursion */
 	elements[elementIndex].inUse = 1;
 	
@@ -706,9 +1003,11 @@ int computeResults(unsigned char mainArray[][32], Element * elements, int totalN
 	int nextIndex = -1;
 	/* For cycle will as many times, as there are options of the element, that are not implacable */
 	for (int cycle = 0; cycle < elements[elementIndex].numberOfOptions - elements[elementIndex].numberOfImplacableOptions; cycle++){
+		/* Randomized heuristic skips random number of remaining options */
+		int skip = control && control->heuristic == HEURISTIC_RANDOM ? randomInRange(&control->randomState, 0, elements[elementIndex].numberOfOptions - elements[elementIndex].numberOfImplacableOptions - cycle - 1) : 0;
 		for (int i = 0; i < elements[elementIndex].numberOfOptions; i++){
 			/* Choose only options, that are not in use */
-			if (!elements[elementIndex].options[i].inUse && !elements[elementIndex].options[i].implacable){
+			if (!elements[elementIndex].options[i].inUse && !elements[elementIndex].options[i].implacable && skip-- == 0){
 				optionIndex = i;
 				elements[elementIndex].options[i].inUse = 1;
 				break;
@@ -716,23 +1015,31 @@ int computeResults(unsigned char mainArray[][32], Element * elements, int totalN
 		}
 		/* Mark all options of all elements, that are implacable by this option */
 		markImplacables(elements, elementIndex, optionIndex);
+		if (control && ++control->nodes == control->maxNodes) return 0;
+		if (control && control->cancelled && control->nodes % CANCEL_CHECK_INTERVAL == 0 && control->cancelled(control->data)) return 0;
 		
 		/* Check for next available index. if -2, impossible to place. If -1, all elements have been used and this element is the last one */
-		nextIndex = findIndexOfBiggestNotInUseElement(elements, totalNumbers);
+		nextIndex = findIndexByHeuristic(elements, totalNumbers, control);
 			//printf("Caller --- id: %d, value: %d ++++++ NextIndex --- id: %d, value: %d\n", elements[elementIndex].id, elements[elementIndex].value, elements[nextIndex].id, elements[nextIndex].value);
 		if (nextIndex != -2){
 			/* Put id of this option into result array */
 			options[spot] = elements[elementIndex].options[optionIndex].id;
-			if (nextIndex != -1) {		
+			if (nextIndex != -1 && control && control->maxDepth && spot + 1 - control->startSpot == control->maxDepth){
+				/* Do not go deeper, rest of this branch is left open for somebody else */
+				control->onFrontier(control->data, elements, options, spot + 1);
+			}else if (nextIndex != -1) {		
 				/* Call next recursion */		
-				if (computeResults(mainArray, elements, totalNumbers, nextIndex, results, options, spot + 1, resultArray, numberOfRows, numberOfCols, alreadyComplete) == 0) return 0;
+				if (computeResults(mainArray, elements, totalNumbers, nextIndex, results, options, spot + 1, resultArray, numberOfRows, numberOfCols, alreadyComplete, control) == 0) return 0;
 			}else {
 				/* In case of last element, fill result array and check, if whole array is filled. If not, result doesnt exist, return 0 */
 				if (*results == 0){
-					fillResultArray(mainArray, totalNumbers, numberOfRows, numberOfCols, options, alreadyComplete, elements, resultArray);
-					if (!wholeFieldFilled(resultArray, numberOfRows, numberOfCols)) return 0;
+					unsigned int rowMasks[32];
+					fillResultArray(mainArray, totalNumbers, numberOfRows, numberOfCols, options, alreadyComplete, elements, resultArray, rowMasks);
+					if (!wholeFieldFilled(rowMasks, numberOfRows, numberOfCols)) return 0;
 				}
 				(*results)++;
+				if (control && control->onResult) control->onResult(control->data, elements, options, spot + 1, *results);
+				if (control && *results == control->maxResults) return 0;
 			}
 		}
 		/* Unmark ONLY options of all elements, that were implaced by this option */
@@ -751,20 +1058,1605 @@ int computeResults(unsigned char mainArray[][32], Element * elements, int totalN
 	return 1;
 }
 
-/*-----------------------------------------MAIN-----------------------------------------*/
+/*-----------------------------------------SESSION-----------------------------------------*/
+
+/*
+*Returns 1, if some rectangle of element can cover field [row, col] on field without other elements
+*/
+int elementCanReach(Element * element, int row, int col, int numberOfRows, int numberOfCols){
 
+	int height = abs(element->row - row) + 1;
+	int width = abs(element->col - col) + 1;
+	for (int division = 1; division <= element->value; division++){
+		/* division is number of rows of rectangle */
+		if (element->value % division != 0) continue;
+		if (division >= height && element->value / division >= width && division <= numberOfRows && element->value / division <= numberOfCols) return 1;
+	}
+	return 0;
+}
 
+/*
+*Computes bounding box of all options of element. Elements with boxes, that dont intersect, cannot collide
+*/
+void computeElementBox(Session * session, int index){
+
+	Element * element = &session->elements[index];
+	char * box = session->boxArr[index];
+	box[0] = box[2] = element->row;
+	box[1] = box[3] = element->col;
+	for (int i = 0; i < element->numberOfOptions; i++){
+		for (int k = 0; k < element->value * 2; k += 2){
+			if (element->options[i].arrayOfIndexes[k] < box[0]) box[0] = element->options[i].arrayOfIndexes[k];
+			if (element->options[i].arrayOfIndexes[k] > box[2]) box[2] = element->options[i].arrayOfIndexes[k];
+			if (element->options[i].arrayOfIndexes[k + 1] < box[1]) box[1] = element->options[i].arrayOfIndexes[k + 1];
+			if (element->options[i].arrayOfIndexes[k + 1] > box[3]) box[3] = element->options[i].arrayOfIndexes[k + 1];
+		}
+	}
+}
+
+/*
+*Return 1, if bounding boxes of two elements intersect
+*/
+int boxesIntersect(char boxA[], char boxB[]){
+
+	return boxA[0] <= boxB[2] && boxB[0] <= boxA[2] && boxA[1] <= boxB[3] && boxB[1] <= boxA[3];
+}
+
+/*
+*Inserts element index and option index of implaced option into implacesArr of option
+*/
+void addImplace(Option * option, int elementIndex, int optionIndex){
+
+	/* realloc if needed */
+	if (option->numberOfImplaces + 2 >= option->maxNumberOfImplaces){
+		option->maxNumberOfImplaces *= 2;
+		int * tmp = (int*) realloc(option->implacesArr, option->maxNumberOfImplaces * sizeof(*tmp));
+		option->implacesArr = tmp;
+	}
+	option->implacesArr[option->numberOfImplaces] = elementIndex;
+	option->implacesArr[option->numberOfImplaces + 1] = optionIndex;
+	option->numberOfImplaces += 2;
+}
+
+/*
+*Frees all options of element, array of options stays allocated for new options
+*/
+void freeElementOptions(Element * element){
+
+	for (int j = 0; j < element->numberOfOptions; j++){
+		free(element->options[j].arrayOfIndexes);
+		free(element->options[j].implacesArr);
+	}
+	element->numberOfOptions = 0;
+}
+
+/*
+*Removes collisions with options of element on provided index from all other elements, that are not affected (NULL for none)
+*/
+void removeImplacesOfElement(Session * session, int index, char affected[]){
+
+	Element * elements = session->elements;
+	for (int i = 0; i < session->totalNumbers; i++){
+		if (i == index || (affected && affected[i]) || !boxesIntersect(session->boxArr[i], session->boxArr[index])) continue;
+		for (int j = 0; j < elements[i].numberOfOptions; j++){
+			Option * option = &elements[i].options[j];
+			int count = 0;
+			for (int k = 0; k < option->numberOfImplaces; k += 2){
+				if (option->implacesArr[k] == index) continue;
+				option->implacesArr[count] = option->implacesArr[k];
+				option->implacesArr[count + 1] = option->implacesArr[k + 1];
+				count += 2;
+			}
+			option->numberOfImplaces = count;
+		}
+	}
+}
+
+/*
+*Finds collisions of all options of element on provided index with options of other elements.
+*Collision is added to both options, unless the other element is affected too (it will add it itself)
+*/
+void fillImplacesOfElement(Session * session, int index, char affected[]){
+
+	Element * elements = session->elements;
+	for (int j = 0; j < elements[index].numberOfOptions; j++){
+		for (int i = 0; i < session->totalNumbers; i++){
+			if (i == index || !boxesIntersect(session->boxArr[i], session->boxArr[index])) continue;
+			for (int l = 0; l < elements[i].numberOfOptions; l++){
+				if (optionsOverlap(&elements[index].options[j], &elements[i].options[l])){
+					addImplace(&elements[index].options[j], i, l);
+					if (!affected[i]) addImplace(&elements[i].options[l], index, j);
+				}
+			}
+		}
+	}
+}
+
+/*
+*Recomputes options and collisions of all affected elements
+*/
+void updateAffectedElements(Session * session, char affected[]){
+
+	for (int i = 0; i < session->totalNumbers; i++) if (affected[i]) removeImplacesOfElement(session, i, affected);
+	for (int i = 0; i < session->totalNumbers; i++){
+		if (!affected[i]) continue;
+		freeElementOptions(&session->elements[i]);
+		findOptionsForElement(session->clueArray, session->elements, i, session->numberOfCols, session->numberOfRows);
+		computeElementBox(session, i);
+	}
+	for (int i = 0; i < session->totalNumbers; i++) if (affected[i]) fillImplacesOfElement(session, i, affected);
+}
+
+/*
+*Moves element to another index of array. Its id, ids of its options and collisions of other elements are changed accordingly
+*/
+void moveElement(Session * session, int from, int to){
+
+	Element * elements = session->elements;
+	elements[to] = elements[from];
+	elements[to].id = to + 1;
+	for (int j = 0; j < elements[to].numberOfOptions; j++) elements[to].options[j].id = elements[to].id * ID_MULTIPLIER + j + 1;
+	for (int k = 0; k < 4; k++) session->boxArr[to][k] = session->boxArr[from][k];
+	for (int i = 0; i < session->totalNumbers; i++){
+		if (i == from || i == to || !boxesIntersect(session->boxArr[i], session->boxArr[to])) continue;
+		for (int j = 0; j < elements[i].numberOfOptions; j++)
+			for (int k = 0; k < elements[i].options[j].numberOfImplaces; k += 2)
+				if (elements[i].options[j].implacesArr[k] == from) elements[i].options[j].implacesArr[k] = to;
+	}
+}
+
+/*
+*Creates session from array of clues. Finds all options of all elements and all collisions between them
+*/
+void createSession(Session * session, unsigned char clueArray[][32], int numberOfRows, int numberOfCols, int totalNumbers){
+
+	char affected[MAX_NUMBER_OF_ELEMENTS];
+	for (int i = 0; i < numberOfRows; i++)
+		for (int j = 0; j < numberOfCols; j++){
+			session->clueArray[i][j] = clueArray[i][j];
+		}
+	session->numberOfRows = numberOfRows;
+	session->numberOfCols = numberOfCols;
+	session->totalNumbers = totalNumbers;
+	session->elements = createStructuresFromElements(session->clueArray, totalNumbers, numberOfRows, numberOfCols);
+	session->elements = (Element*) realloc(session->elements, MAX_NUMBER_OF_ELEMENTS * sizeof(*session->elements));
+	findAllOptionsForElements(session->clueArray, session->elements, totalNumbers, numberOfCols, numberOfRows);
+	for (int i = 0; i < totalNumbers; i++){
+		computeElementBox(session, i);
+		affected[i] = 1;
+	}
+	for (int i = 0; i < totalNumbers; i++) fillImplacesOfElement(session, i, affected);
+}
+
+/*
+*Returns index of element on field [row, col] or -1, if there is none
+*/
+int findElementOnField(Session * session, int row, int col){
+
+	for (int i = 0; i < session->totalNumbers; i++)
+		if (session->elements[i].row == row && session->elements[i].col == col) return i;
+	return -1;
+}
+
+/*
+*Adds new clue into empty field. Recomputes only elements, that can reach this field
+*Returns 0, if clue cannot be added
+*/
+int sessionAddClue(Session * session, int row, int col, int value){
+
+	char affected[MAX_NUMBER_OF_ELEMENTS];
+	if (row < 0 || row >= session->numberOfRows || col < 0 || col >= session->numberOfCols || value < 1 || value > 99
+	|| session->clueArray[row][col] != 0 || session->totalNumbers == MAX_NUMBER_OF_ELEMENTS) return 0;
+
+	int index = session->totalNumbers++;
+	session->clueArray[row][col] = value;
+	initElement(&session->elements[index], index + 1, row, col, value);
+	computeElementBox(session, index);
+	for (int i = 0; i < session->totalNumbers; i++)
+		affected[i] = i == index || elementCanReach(&session->elements[i], row, col, session->numberOfRows, session->numberOfCols);
+	updateAffectedElements(session, affected);
+	return 1;
+}
+
+/*
+*Removes clue from field. Last element is moved on its place in array, so ids stay continuous
+*Recomputes only elements, that can reach this field
+*Returns 0, if there is no clue on this field
+*/
+int sessionRemoveClue(Session * session, int row, int col){
+
+	char affected[MAX_NUMBER_OF_ELEMENTS];
+	if (row < 0 || row >= session->numberOfRows || col < 0 || col >= session->numberOfCols) return 0;
+	int index = findElementOnField(session, row, col);
+	if (index == -1) return 0;
+
+	removeImplacesOfElement(session, index, NULL);
+	freeElementOptions(&session->elements[index]);
+	free(session->elements[index].options);
+	if (index != session->totalNumbers - 1) moveElement(session, session->totalNumbers - 1, index);
+	session->totalNumbers--;
+	session->clueArray[row][col] = 0;
+	for (int i = 0; i < session->totalNumbers; i++)
+		affected[i] = elementCanReach(&session->elements[i], row, col, session->numberOfRows, session->numberOfCols);
+	updateAffectedElements(session, affected);
+	return 1;
+}
+
+/*
+*Changes value of clue. Other elements are not affected, because they are only blocked by position of clue
+*Returns 0, if there is no clue on this field or value is wrong
+*/
+int sessionChangeValue(Session * session, int row, int col, int value){
+
+	char affected[MAX_NUMBER_OF_ELEMENTS];
+	if (row < 0 || row >= session->numberOfRows || col < 0 || col >= session->numberOfCols || value < 1 || value > 99) return 0;
+	int index = findElementOnField(session, row, col);
+	if (index == -1) return 0;
+
+	session->elements[index].value = value;
+	session->clueArray[row][col] = value;
+	for (int i = 0; i < session->totalNumbers; i++) affected[i] = i == index;
+	updateAffectedElements(session, affected);
+	return 1;
+}
+
+/*
+*Marks options, that would block all remaining options of some other element, as implacable
+*and computes mediumNumberOfImplaces of elements. Same as fillImplacableArrays does, but on complete collisions
+*/
+void markBlockingOptions(Session * session){
+
+	Element * elements = session->elements;
+	int counts[MAX_NUMBER_OF_ELEMENTS] = {0};
+	int touched[MAX_NUMBER_OF_ELEMENTS];
+	for (int i = 0; i < session->totalNumbers; i++){
+		if (elements[i].inUse) continue;
+		for (int j = 0; j < elements[i].numberOfOptions; j++){
+			Option * option = &elements[i].options[j];
+			if (option->implacable) continue;
+			int numberOfTouched = 0, totalCount = 0, blocking = 0;
+			for (int k = 0; k < option->numberOfImplaces; k += 2){
+				int elIndex = option->implacesArr[k];
+				if (elements[elIndex].inUse || elements[elIndex].options[option->implacesArr[k + 1]].implacable) continue;
+				if (counts[elIndex]++ == 0) touched[numberOfTouched++] = elIndex;
+				totalCount++;
+			}
+			for (int k = 0; k < numberOfTouched; k++){
+				if (counts[touched[k]] + elements[touched[k]].numberOfImplacableOptions == elements[touched[k]].numberOfOptions) blocking = 1;
+				counts[touched[k]] = 0;
+			}
+			if (blocking){
+				option->implacable = 1;
+				option->implacedBy = PREPROCESSOR_ID;
+				elements[i].numberOfImplacableOptions += 1;
+			} else elements[i].mediumNumberOfImplaces += totalCount;
+		}
+		elements[i].mediumNumberOfImplaces /= (elements[i].numberOfOptions * 10);
+	}
+}
+
+/*
+*Resets state left by previous search. Returns total area of all elements
+*/
+int resetSessionState(Session * session){
+
+	Element * elements = session->elements;
+	int area = 0;
+	for (int i = 0; i < session->totalNumbers; i++){
+		area += elements[i].value;
+		elements[i].inUse = 0;
+		elements[i].numberOfImplacableOptions = 0;
+		elements[i].mediumNumberOfImplaces = 0;
+		for (int j = 0; j < elements[i].numberOfOptions; j++){
+			elements[i].options[j].inUse = 0;
+			elements[i].options[j].implacable = 0;
+			elements[i].options[j].implacedBy = 0;
+		}
+	}
+	return area;
+}
+
+/*
+*Searches from current state of session, where first spot ids of options are already placed.
+*Elements with only one possible option are placed first, then recursive backtracking searches the rest
+*Returns number of results, but search stops at limits of control (can be NULL). resultArray holds first result
+*/
+long long sessionSearch(Session * session, int options[], int spot, unsigned char resultArray[][32], SearchControl * control){
+
+	Element * elements = session->elements;
+	unsigned char emptyArray[32][32] = {{0}};
+	unsigned int rowMasks[32];
+	long long results = 0;
+	int found = 1;
+	/* place elements with only one possible option, until there are none */
+	while (found){
+		found = 0;
+		for (int i = 0; i < session->totalNumbers; i++){
+			if (elements[i].inUse) continue;
+			if (elements[i].numberOfOptions - elements[i].numberOfImplacableOptions == 0) return 0;
+			if (elements[i].numberOfOptions - elements[i].numberOfImplacableOptions == 1){
+				int index = 0;
+				while (elements[i].options[index].implacable) index++;
+				elements[i].inUse = 1;
+				options[spot++] = elements[i].options[index].id;
+				markImplacables(elements, i, index);
+				found = 1;
+			}
+		}
+	}
+	/* all elements are placed and they do not overlap, so field is filled */
+	if (spot == session->totalNumbers){
+		fillResultArray(emptyArray, session->totalNumbers, session->numberOfRows, session->numberOfCols, options, 0, elements, resultArray, rowMasks);
+		if (control && control->onResult) control->onResult(control->data, elements, options, spot, 1);
+		return 1;
+	}
+	markBlockingOptions(session);
+	int index = findIndexByHeuristic(elements, session->totalNumbers, control);
+	if (index < 0) return 0;
+	if (control) control->startSpot = spot;
+	computeResults(emptyArray, elements, session->totalNumbers, index, &results, options, spot, resultArray, session->numberOfRows, session->numberOfCols, 0, control);
+	return results;
+}
+
+/*
+*Solves current state of session
+*Returns number of results, but search stops at limits of control (can be NULL). resultArray holds first result
+*/
+long long sessionSolve(Session * session, unsigned char resultArray[][32], SearchControl * control){
+
+	int options[MAX_NUMBER_OF_ELEMENTS + 1];
+	if (session->totalNumbers == 0) return 0;
+	/* rectangles cannot fill whole field */
+	if (resetSessionState(session) != session->numberOfRows * session->numberOfCols) return 0;
+	return sessionSearch(session, options, 0, resultArray, control);
+}
+
+/*
+*Edit mode. Reads puzzle from file (or creates empty field of given size), then reads edits from stdin, one per line:
+*	a row col value	- add clue
+*	r row col		- remove clue
+*	c row col value	- change value of clue
+*Rows and cols are counted from 0. After every edit prints, if puzzle has none, one or more solutions
+*/
+int runEditMode(int argc, char * argv[]){
+
+	unsigned char mainArray[32][32] = {{0}};
+	unsigned char resultArray[32][32];
+	int numberOfRows = 0, numberOfCols = 0, totalNumbers = 0;
+	int row, col, value;
+	char line[64], command;
+	Session session;
+
+	if (argc == 3){
+		FILE * file = fopen(argv[2], "r");
+		if (!file || !readInput(file, mainArray, &numberOfRows, &numberOfCols, &totalNumbers)){
+			printf("Nespravny vstup.\n");
+			if (file) fclose(file);
+			return 1;
+		}
+		fclose(file);
+	} else if (argc != 4 || sscanf(argv[2], "%d", &numberOfRows) != 1 || sscanf(argv[3], "%d", &numberOfCols) != 1
+	|| numberOfRows < 1 || numberOfRows > 32 || numberOfCols < 1 || numberOfCols > 32){
+		printf("Nespravny vstup.\n");
+		return 1;
+	}
+	createSession(&session, mainArray, numberOfRows, numberOfCols, totalNumbers);
+
+	while (fgets(line, sizeof(line), stdin)){
+		int ok = 0;
+		if (sscanf(line, " %c", &command) != 1) continue;
+		if (command == 'a' && sscanf(line, " %*c %d %d %d", &row, &col, &value) == 3) ok = sessionAddClue(&session, row, col, value);
+		else if (command == 'r' && sscanf(line, " %*c %d %d", &row, &col) == 2) ok = sessionRemoveClue(&session, row, col);
+		else if (command == 'c' && sscanf(line, " %*c %d %d %d", &row, &col, &value) == 3) ok = sessionChangeValue(&session, row, col, value);
+
+		if (!ok) printf("Nespravny vstup.\n");
+		else {
+			/* two results are enough to say, that solution is not unique */
+			SearchControl control = {0};
+			control.maxResults = 2;
+			int results = sessionSolve(&session, resultArray, &control);
+			if (results > 1) printf("Reseni neni jednoznacne.\n");
+			else if (results == 1) printResult(resultArray, session.elements, session.totalNumbers, numberOfRows, numberOfCols);
+			else printf("Reseni neexistuje.\n");
+		}
+		fflush(stdout);
+	}
+
+	freeMemory(session.elements, session.totalNumbers);
+	return 0;
+}
+
+/*-----------------------------------------GENERATOR-----------------------------------------*/
+
+/*
+*Returns 1, if two rectangles are neighbours and together they form a rectangle
+*/
+int rectanglesMergeable(Rectangle * a, Rectangle * b){
+
+	if (a->top == b->top && a->bottom == b->bottom && (a->right + 1 == b->left || b->right + 1 == a->left)) return 1;
+	if (a->left == b->left && a->right == b->right && (a->bottom + 1 == b->top || b->bottom + 1 == a->top)) return 1;
+	return 0;
+}
+
+/*
+*Merges rectangle b into rectangle a, clue of a stays
+*/
+void mergeRectangles(Rectangle * a, Rectangle * b){
+
+	if (b->top < a->top) a->top = b->top;
+	if (b->left < a->left) a->left = b->left;
+	if (b->bottom > a->bottom) a->bottom = b->bottom;
+	if (b->right > a->right) a->right = b->right;
+}
+
+/*
+*Returns area of rectangle
+*/
+int rectangleArea(Rectangle * rectangle){
+
+	return (rectangle->bottom - rectangle->top + 1) * (rectangle->right - rectangle->left + 1);
+}
+
+/*
+*Creates random partition of field into rectangles, from left top to right bottom.
+*Every rectangle gets clue on random field. Neighbours are merged, until there are at most MAX_NUMBER_OF_ELEMENTS rectangles
+*Returns number of rectangles
+*/
+int createRandomPartition(Rectangle rectangles[], int numberOfRows, int numberOfCols, unsigned long long * state){
+
+	unsigned char coveredArr[32][32] = {{0}};
+	int numberOfRectangles = 0;
+	for (int i = 0; i < numberOfRows; i++){
+		for (int j = 0; j < numberOfCols; j++){
+			if (coveredArr[i][j]) continue;
+			/* fields above are already covered, so width is limited only by covered fields on the right */
+			int maxWidth = 0, maxHeight = 0;
+			while (j + maxWidth < numberOfCols && maxWidth < GENERATOR_MAX_SIDE && !coveredArr[i][j + maxWidth]) maxWidth++;
+			int width = randomInRange(state, 1, maxWidth);
+			while (i + maxHeight < numberOfRows && maxHeight < GENERATOR_MAX_SIDE){
+				int free = 1;
+				for (int l = 0; l < width; l++) if (coveredArr[i + maxHeight][j + l]) free = 0;
+				if (!free) break;
+				maxHeight++;
+			}
+			if (maxHeight > GENERATOR_MAX_AREA / width) maxHeight = GENERATOR_MAX_AREA / width;
+			int height = randomInRange(state, 1, maxHeight);
+			for (int k = 0; k < height; k++)
+				for (int l = 0; l < width; l++) coveredArr[i + k][j + l] = 1;
+			Rectangle * rectangle = &rectangles[numberOfRectangles++];
+			rectangle->top = i;
+			rectangle->left = j;
+			rectangle->bottom = i + height - 1;
+			rectangle->right = j + width - 1;
+		}
+	}
+	/* merge random neighbours, so puzzle does not have too many elements */
+	while (numberOfRectangles > MAX_NUMBER_OF_ELEMENTS){
+		int a = randomInRange(state, 0, numberOfRectangles - 1);
+		for (int b = 0; b < numberOfRectangles; b++){
+			if (b == a || !rectanglesMergeable(&rectangles[a], &rectangles[b]) || rectangleArea(&rectangles[a]) + rectangleArea(&rectangles[b]) > 99) continue;
+			mergeRectangles(&rectangles[a], &rectangles[b]);
+			rectangles[b] = rectangles[--numberOfRectangles];
+			break;
+		}
+	}
+	for (int i = 0; i < numberOfRectangles; i++){
+		rectangles[i].row = randomInRange(state, rectangles[i].top, rectangles[i].bottom);
+		rectangles[i].col = randomInRange(state, rectangles[i].left, rectangles[i].right);
+	}
+	return numberOfRectangles;
+}
+
+/*
+*Returns 1, if puzzle in session has only one solution. Search stops at the second solution.
+*Puzzles, that need more than GENERATOR_MAX_NODES placements to decide, are taken as ambiguous
+*/
+int puzzleIsUnique(Session * session){
+
+	unsigned char resultArray[32][32];
+	SearchControl control = {0};
+	control.maxResults = 2;
+	control.maxNodes = GENERATOR_MAX_NODES;
+	return sessionSolve(session, resultArray, &control) == 1 && control.nodes < GENERATOR_MAX_NODES;
+}
+
+/*
+*Moves clues of random rectangles to other fields of the same rectangle, until puzzle has only one solution
+*Returns 1, if it succeeded
+*/
+int relocateCluesUntilUnique(Session * session, Rectangle rectangles[], int numberOfRectangles, unsigned long long * state){
+
+	for (int attempt = 0; attempt < GENERATOR_RELOCATIONS; attempt++){
+		Rectangle * rectangle = &rectangles[randomInRange(state, 0, numberOfRectangles - 1)];
+		if (rectangleArea(rectangle) == 1) continue;
+		int row = randomInRange(state, rectangle->top, rectangle->bottom);
+		int col = randomInRange(state, rectangle->left, rectangle->right);
+		if (row == rectangle->row && col == rectangle->col) continue;
+		sessionRemoveClue(session, rectangle->row, rectangle->col);
+		sessionAddClue(session, row, col, rectangleArea(rectangle));
+		rectangle->row = row;
+		rectangle->col = col;
+		if (puzzleIsUnique(session)) return 1;
+	}
+	return 0;
+}
+
+/*
+*Removes clues by merging neighbouring rectangles, while puzzle keeps only one solution.
+*Merge, that makes solution ambiguous, is reverted. Returns new number of rectangles
+*/
+int removeCluesWhileUnique(Session * session, Rectangle rectangles[], int numberOfRectangles, unsigned long long * state){
+
+	int merged = 1;
+	while (merged){
+		merged = 0;
+		int start = randomInRange(state, 0, numberOfRectangles - 1);
+		for (int k = 0; k < numberOfRectangles; k++){
+			int a = (start + k) % numberOfRectangles;
+			for (int b = 0; b < numberOfRectangles; b++){
+				if (b == a || !rectanglesMergeable(&rectangles[a], &rectangles[b])) continue;
+				int areaA = rectangleArea(&rectangles[a]), areaB = rectangleArea(&rectangles[b]);
+				if (areaA + areaB > GENERATOR_MAX_AREA) continue;
+				sessionRemoveClue(session, rectangles[b].row, rectangles[b].col);
+				sessionChangeValue(session, rectangles[a].row, rectangles[a].col, areaA + areaB);
+				if (puzzleIsUnique(session)){
+					mergeRectangles(&rectangles[a], &rectangles[b]);
+					rectangles[b] = rectangles[--numberOfRectangles];
+					merged = 1;
+					break;
+				}
+				/* revert merge */
+				sessionChangeValue(session, rectangles[a].row, rectangles[a].col, areaA);
+				sessionAddClue(session, rectangles[b].row, rectangles[b].col, areaB);
+			}
+			if (merged) break;
+		}
+	}
+	return numberOfRectangles;
+}
+
+/*
+*Returns time in seconds from some fixed point
+*/
+double currentTime(void){
+
+	struct timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return time.tv_sec + time.tv_nsec / 1e9;
+}
+
+/*
+*One thread of generator. Generates candidates, until enough puzzles with only one solution were printed
+*/
+void * generatorWorker(void * argument){
+
+	GeneratorWorker * worker = (GeneratorWorker*) argument;
+	Generator * generator = worker->generator;
+	Rectangle rectangles[32 * 32];
+	unsigned char clueArray[32][32];
+	Session session;
+
+	while (1){
+		pthread_mutex_lock(&generator->mutex);
+		int finished = generator->produced >= generator->count;
+		generator->candidates++;
+		pthread_mutex_unlock(&generator->mutex);
+		if (finished) break;
+
+		int numberOfRectangles = createRandomPartition(rectangles, generator->numberOfRows, generator->numberOfCols, &worker->randomState);
+		memset(clueArray, 0, sizeof(clueArray));
+		for (int i = 0; i < numberOfRectangles; i++) clueArray[(int)rectangles[i].row][(int)rectangles[i].col] = rectangleArea(&rectangles[i]);
+		createSession(&session, clueArray, generator->numberOfRows, generator->numberOfCols, numberOfRectangles);
+		if (puzzleIsUnique(&session) || relocateCluesUntilUnique(&session, rectangles, numberOfRectangles, &worker->randomState)){
+			removeCluesWhileUnique(&session, rectangles, numberOfRectangles, &worker->randomState);
+			pthread_mutex_lock(&generator->mutex);
+			if (generator->produced < generator->count){
+				printPuzzle(session.clueArray, generator->numberOfRows, generator->numberOfCols);
+				printf("\n");
+				generator->produced++;
+			}
+			pthread_mutex_unlock(&generator->mutex);
+		}
+		freeMemory(session.elements, session.totalNumbers);
+	}
+	return NULL;
+}
+
+/*
+*Generator mode. Generates given number of puzzles with only one solution on all cores
+*and prints them separated by empty line. Speed is reported on stderr
+*/
+int runGeneratorMode(int argc, char * argv[]){
+
+	Generator generator;
+	unsigned long long seed = 1;
+	if ((argc != 5 && argc != 6) || sscanf(argv[2], "%d", &generator.numberOfRows) != 1 || sscanf(argv[3], "%d", &generator.numberOfCols) != 1
+	|| sscanf(argv[4], "%d", &generator.count) != 1 || (argc == 6 && sscanf(argv[5], "%llu", &seed) != 1)
+	|| generator.numberOfRows < 1 || generator.numberOfRows > 32 || generator.numberOfCols < 1 || generator.numberOfCols > 32 || generator.count < 1){
+		printf("Nespravny vstup.\n");
+		return 1;
+	}
+	generator.produced = 0;
+	generator.candidates = 0;
+	pthread_mutex_init(&generator.mutex, NULL);
+
+	int numberOfThreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+	if (numberOfThreads < 1) numberOfThreads = 1;
+	pthread_t * threads = (pthread_t*) malloc(numberOfThreads * sizeof(*threads));
+	GeneratorWorker * workers = (GeneratorWorker*) malloc(numberOfThreads * sizeof(*workers));
+
+	double start = currentTime();
+	for (int i = 0; i < numberOfThreads; i++){
+		workers[i].generator = &generator;
+		/* state of xorshift cannot be 0 */
+		workers[i].randomState = (seed + i) * 0x9E3779B97F4A7C15ULL | 1;
+		pthread_create(&threads[i], NULL, generatorWorker, &workers[i]);
+	}
+	for (int i = 0; i < numberOfThreads; i++) pthread_join(threads[i], NULL);
+	double elapsed = currentTime() - start;
+
+	fprintf(stderr, "Vygenerovano %d puzzle z %lld kandidatu za %.3f s (%.1f puzzle/s, %d vlaken)\n",
+		generator.produced, generator.candidates - numberOfThreads, elapsed, generator.produced / elapsed, numberOfThreads);
+
+	pthread_mutex_destroy(&generator.mutex);
+	free(threads);
+	free(workers);
+	return 0;
+}
+
+/*-----------------------------------------BINARY FORMAT-----------------------------------------*/
+
+/*
+*Binary stream starts with header: magic "SHKP" (puzzles) or "SHKS" (solutions) and version (4B).
+*Records follow without any separators, all numbers are little endian:
+*	puzzle:		rows (1B), cols (1B), numberOfClues (2B), numberOfClues times {row, col, value} (1B each)
+*				wrong puzzle is written with 0 rows and 0 cols, so records stay aligned with input
+*	solution:	verdict (1B), rows (1B), cols (1B), count (8B), hash of puzzle (4B), numberOfRectangles (2B),
+*				numberOfRectangles times {row, col, top, left, bottom, right} (1B each), where row and col are coordinates of clue
+*				rectangles are written for verdict BINARY_ONE_SOLUTION, for BINARY_MORE_SOLUTIONS they can hold one of solutions
+*				hash of puzzle is FNV-1a of its puzzle record, it tells, if results of cubes belong to the same puzzle
+*Index file (name of stream + ".idx") has magic "SHKI", version (4B), numberOfRecords (8B) and offset (8B)
+*of every record from the beginning of stream, so offset of record i is on position 16 + 8 * i of mmap-ed index
+*Enumeration stream ("SHKE") is described in section ENUMERATION, cube file ("SHKC") in section CUBE AND CONQUER
+*/
+
+/*
+*Writes number into buffer as little endian of given number of bytes
+*/
+void writeLittleEndian(unsigned char buffer[], unsigned long long value, int numberOfBytes){
+
+	for (int i = 0; i < numberOfBytes; i++) buffer[i] = (value >> (8 * i)) & 0xFF;
+}
+
+/*
+*Reads little endian number of given number of bytes from buffer
+*/
+unsigned long long readLittleEndian(unsigned char buffer[], int numberOfBytes){
+
+	unsigned long long value = 0;
+	for (int i = numberOfBytes - 1; i >= 0; i--) value = (value << 8) | buffer[i];
+	return value;
+}
+
+/*
+*Opens binary stream for writing (NULL or "-" for stdout, then no index is written) and writes its header
+*Returns 0, if some file cannot be opened
+*/
+int openBinaryWriter(BinaryWriter * writer, const char * fileName, const char * magic){
+
+	unsigned char header[INDEX_HEADER_SIZE] = {0};
+	writer->position = BINARY_HEADER_SIZE;
+	writer->numberOfRecords = 0;
+	writer->index = NULL;
+	if (!fileName || strcmp(fileName, "-") == 0) writer->stream = stdout;
+	else {
+		char * indexName = (char*) malloc(strlen(fileName) + 5);
+		sprintf(indexName, "%s.idx", fileName);
+		writer->stream = fopen(fileName, "wb");
+		writer->index = fopen(indexName, "wb");
+		free(indexName);
+		if (!writer->stream || !writer->index){
+			if (writer->stream) fclose(writer->stream);
+			if (writer->index) fclose(writer->index);
+			return 0;
+		}
+		/* number of records is written, when writer is closed */
+		memcpy(header, INDEX_MAGIC, 4);
+		writeLittleEndian(header + 4, BINARY_VERSION, 4);
+		fwrite(header, 1, INDEX_HEADER_SIZE, writer->index);
+	}
+	memcpy(header, magic, 4);
+	writeLittleEndian(header + 4, BINARY_VERSION, 4);
+	fwrite(header, 1, BINARY_HEADER_SIZE, writer->stream);
+	return 1;
+}
+
+/*
+*Writes one record into stream and its offset into index
+*/
+void writeBinaryRecord(BinaryWriter * writer, unsigned char buffer[], int length){
+
+	unsigned char offset[8];
+	if (writer->index){
+		writeLittleEndian(offset, writer->position, 8);
+		fwrite(offset, 1, 8, writer->index);
+	}
+	fwrite(buffer, 1, length, writer->stream);
+	writer->position += length;
+	writer->numberOfRecords++;
+}
+
+/*
+*Completes index with number of records and closes all files of writer
+*/
+void closeBinaryWriter(BinaryWriter * writer){
+
+	unsigned char count[8];
+	if (writer->index){
+		writeLittleEndian(count, writer->numberOfRecords, 8);
+		fseek(writer->index, 8, SEEK_SET);
+		fwrite(count, 1, 8, writer->index);
+		fclose(writer->index);
+	}
+	if (writer->stream == stdout) fflush(stdout);
+	else fclose(writer->stream);
+}
+
+/*
+*Reads header of binary stream and returns last letter of its magic ('P' for puzzles, 'S' for solutions, 'E' for enumeration, 'C' for cube)
+*Returns 0, if stream is not binary stream of supported version
+*/
+int readBinaryHeader(FILE * stream){
+
+	unsigned char header[BINARY_HEADER_SIZE];
+	if (fread(header, 1, BINARY_HEADER_SIZE, stream) != BINARY_HEADER_SIZE || readLittleEndian(header + 4, 4) != BINARY_VERSION) return 0;
+	if (memcmp(header, PUZZLE_MAGIC, 4) == 0 || memcmp(header, SOLUTION_MAGIC, 4) == 0 || memcmp(header, ENUMERATION_MAGIC, 4) == 0
+	|| memcmp(header, CUBE_MAGIC, 4) == 0) return header[3];
+	return 0;
+}
+
+/*
+*Writes puzzle record into buffer, clues are written from left top to right bottom. Returns length of record
+*/
+int encodePuzzle(unsigned char buffer[], unsigned char clueArray[][32], int numberOfRows, int numberOfCols){
+
+	int length = 4, numberOfClues = 0;
+	for (int i = 0; i < numberOfRows; i++){
+		for (int j = 0; j < numberOfCols; j++){
+			if (clueArray[i][j] == 0) continue;
+			buffer[length++] = i;
+			buffer[length++] = j;
+			buffer[length++] = clueArray[i][j];
+			numberOfClues++;
+		}
+	}
+	buffer[0] = numberOfRows;
+	buffer[1] = numberOfCols;
+	writeLittleEndian(buffer + 2, numberOfClues, 2);
+	return length;
+}
+
+/*
+*Reads one puzzle record into clue array. Checks same conditions as readInput
+*Returns 1, if puzzle was read, -1, if record was read, but puzzle is wrong, 0 at the end of stream
+*and -2 for damaged record (truncated or with too many clues), after which stream cannot be read anymore
+*/
+int readPuzzleRecord(FILE * stream, unsigned char clueArray[][32], int * numberOfRows, int * numberOfCols, int * totalNumbers){
+
+	unsigned char buffer[MAX_PUZZLE_RECORD_SIZE];
+	int wrong = 0;
+	/* stream can end only between records */
+	size_t length = fread(buffer, 1, 4, stream);
+	if (length == 0) return 0;
+	if (length != 4) return -2;
+	*numberOfRows = buffer[0];
+	*numberOfCols = buffer[1];
+	*totalNumbers = readLittleEndian(buffer + 2, 2);
+	if (*totalNumbers > MAX_NUMBER_OF_ELEMENTS) return -2;
+	if (fread(buffer + 4, 3, *totalNumbers, stream) != (size_t)*totalNumbers) return -2;
+	if (*numberOfRows < 1 || *numberOfRows > 32 || *numberOfCols < 1 || *numberOfCols > 32 || *totalNumbers == 0) return -1;
+
+	for (int i = 0; i < *numberOfRows; i++)
+		for (int j = 0; j < *numberOfCols; j++) clueArray[i][j] = 0;
+	for (int i = 0; i < *totalNumbers; i++){
+		int row = buffer[4 + 3 * i], col = buffer[5 + 3 * i], value = buffer[6 + 3 * i];
+		if (row >= *numberOfRows || col >= *numberOfCols || value < 1 || value > 99 || clueArray[row][col] != 0) wrong = 1;
+		else clueArray[row][col] = value;
+	}
+	return wrong ? -1 : 1;
+}
+
+/*
+*Returns hash of puzzle (FNV-1a of its puzzle record)
+*/
+unsigned int puzzleHash(unsigned char clueArray[][32], int numberOfRows, int numberOfCols){
+
+	unsigned char buffer[MAX_PUZZLE_RECORD_SIZE];
+	int length = encodePuzzle(buffer, clueArray, numberOfRows, numberOfCols);
+	unsigned int hash = 2166136261u;
+	for (int i = 0; i < length; i++){
+		hash ^= buffer[i];
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+/*
+*Writes solution record into buffer. Returns length of record
+*/
+int encodeSolution(unsigned char buffer[], int verdict, unsigned long long count, unsigned int hash, int numberOfRows, int numberOfCols, Rectangle rectangles[], int numberOfRectangles){
+
+	int length = 17;
+	buffer[0] = verdict;
+	buffer[1] = numberOfRows;
+	buffer[2] = numberOfCols;
+	writeLittleEndian(buffer + 3, count, 8);
+	writeLittleEndian(buffer + 11, hash, 4);
+	writeLittleEndian(buffer + 15, numberOfRectangles, 2);
+	for (int i = 0; i < numberOfRectangles; i++){
+		buffer[length++] = rectangles[i].row;
+		buffer[length++] = rectangles[i].col;
+		buffer[length++] = rectangles[i].top;
+		buffer[length++] = rectangles[i].left;
+		buffer[length++] = rectangles[i].bottom;
+		buffer[length++] = rectangles[i].right;
+	}
+	return length;
+}
+
+/*
+*Returns 1, if rectangle read from binary stream lies in field of given size, contains its clue
+*and its area is possible value of clue
+*/
+int rectangleValid(Rectangle * rectangle, int numberOfRows, int numberOfCols){
+
+	return rectangle->top <= rectangle->row && rectangle->row <= rectangle->bottom && rectangle->bottom < numberOfRows
+		&& rectangle->left <= rectangle->col && rectangle->col <= rectangle->right && rectangle->right < numberOfCols
+		&& rectangleArea(rectangle) <= 99;
+}
+
+/*
+*Reads one solution record. Returns 1, if record was read, 0 at the end of stream and -2 for damaged record
+*/
+int readSolutionRecord(FILE * stream, int * verdict, unsigned long long * count, unsigned int * hash, int * numberOfRows, int * numberOfCols, Rectangle rectangles[], int * numberOfRectangles){
+
+	unsigned char buffer[MAX_SOLUTION_RECORD_SIZE];
+	/* stream can end only between records */
+	size_t length = fread(buffer, 1, 17, stream);
+	if (length == 0) return 0;
+	if (length != 17) return -2;
+	*verdict = buffer[0];
+	*numberOfRows = buffer[1];
+	*numberOfCols = buffer[2];
+	*count = readLittleEndian(buffer + 3, 8);
+	*hash = readLittleEndian(buffer + 11, 4);
+	*numberOfRectangles = readLittleEndian(buffer + 15, 2);
+	if (*numberOfRectangles > MAX_NUMBER_OF_ELEMENTS || *numberOfRows > 32 || *numberOfCols > 32) return -2;
+	if (fread(buffer + 17, 6, *numberOfRectangles, stream) != (size_t)*numberOfRectangles) return -2;
+	for (int i = 0; i < *numberOfRectangles; i++){
+		rectangles[i].row = buffer[17 + 6 * i];
+		rectangles[i].col = buffer[18 + 6 * i];
+		rectangles[i].top = buffer[19 + 6 * i];
+		rectangles[i].left = buffer[20 + 6 * i];
+		rectangles[i].bottom = buffer[21 + 6 * i];
+		rectangles[i].right = buffer[22 + 6 * i];
+		if (!rectangleValid(&rectangles[i], *numberOfRows, *numberOfCols)) return -2;
+	}
+	return 1;
+}
+
+/*
+*Converts result array with ids of elements into rectangles. Returns number of rectangles
+*/
+int resultToRectangles(unsigned char resultArray[][32], Element * elements, int totalNumbers, int numberOfRows, int numberOfCols, Rectangle rectangles[]){
+
+	for (int i = 0; i < totalNumbers; i++){
+		rectangles[i].row = rectangles[i].top = rectangles[i].bottom = elements[i].row;
+		rectangles[i].col = rectangles[i].left = rectangles[i].right = elements[i].col;
+	}
+	for (int i = 0; i < numberOfRows; i++){
+		for (int j = 0; j < numberOfCols; j++){
+			Rectangle * rectangle = &rectangles[resultArray[i][j] - 1];
+			if (i < rectangle->top) rectangle->top = i;
+			if (i > rectangle->bottom) rectangle->bottom = i;
+			if (j < rectangle->left) rectangle->left = j;
+			if (j > rectangle->right) rectangle->right = j;
+		}
+	}
+	return totalNumbers;
+}
+
+/*
+*Prints solution given by rectangles in the same format as printBoard
+*/
+void printRectangles(Rectangle rectangles[], int numberOfRectangles, int numberOfRows, int numberOfCols){
+
+	unsigned char resultArray[32][32] = {{0}};
+	Element elements[MAX_NUMBER_OF_ELEMENTS];
+	for (int i = 0; i < numberOfRectangles; i++){
+		elements[i].row = rectangles[i].row;
+		elements[i].col = rectangles[i].col;
+		elements[i].value = rectangleArea(&rectangles[i]);
+		for (int k = rectangles[i].top; k <= rectangles[i].bottom; k++)
+			for (int l = rectangles[i].left; l <= rectangles[i].right; l++) resultArray[k][l] = i + 1;
+	}
+	printBoard(resultArray, elements, numberOfRectangles, numberOfRows, numberOfCols);
+}
+
+/*
+*Reads next puzzle from stream of ASCII puzzles separated by empty lines (as printed by generator)
+*Returns 1, if puzzle was read, -1, if puzzle is in wrong format, 0 at the end of stream
+*/
+int readNextAsciiPuzzle(FILE * stream, unsigned char mainArray[][32], int * numberOfRows, int * numberOfCols, int * totalNumbers){
+
+	/* 65 lines of 32x32 field, each with '\n' */
+	char block[65 * (MAX_NUMBER_OF_CHARS + 1) + 1];
+	char line[MAX_NUMBER_OF_CHARS + 2];
+	int length = 0, overflow = 0;
+	while (fgets(line, sizeof(line), stream)){
+		int lineLength = strlen(line);
+		if (strcmp(line, "\n") == 0){
+			/* skip empty lines before puzzle */
+			if (length == 0 && !overflow) continue;
+			break;
+		}
+		if (length + lineLength >= (int)sizeof(block)) overflow = 1;
+		else {
+			memcpy(block + length, line, lineLength);
+			length += lineLength;
+		}
+	}
+	if (length == 0 && !overflow) return 0;
+	if (overflow) return -1;
+
+	*numberOfRows = *numberOfCols = *totalNumbers = 0;
+	FILE * puzzle = fmemopen(block, length, "r");
+	int ok = readInput(puzzle, mainArray, numberOfRows, numberOfCols, totalNumbers);
+	fclose(puzzle);
+	return ok ? 1 : -1;
+}
+
+/*
+*Converts stream of ASCII puzzles into binary stream of puzzles
+*/
+int convertAsciiToBinary(const char * inputName, const char * outputName){
+
+	unsigned char mainArray[32][32];
+	unsigned char buffer[MAX_PUZZLE_RECORD_SIZE];
+	int numberOfRows, numberOfCols, totalNumbers, state;
+	BinaryWriter writer;
+	FILE * input = strcmp(inputName, "-") == 0 ? stdin : fopen(inputName, "r");
+	if (!input || !openBinaryWriter(&writer, outputName, PUZZLE_MAGIC)){
+		printf("Nespravny vstup.\n");
+		if (input && input != stdin) fclose(input);
+		return 1;
+	}
+	while ((state = readNextAsciiPuzzle(input, mainArray, &numberOfRows, &numberOfCols, &totalNumbers)) != 0){
+		if (state == 1) writeBinaryRecord(&writer, buffer, encodePuzzle(buffer, mainArray, numberOfRows, numberOfCols));
+		else writeBinaryRecord(&writer, buffer, encodePuzzle(buffer, mainArray, 0, 0));
+	}
+	closeBinaryWriter(&writer);
+	if (input != stdin) fclose(input);
+	return 0;
+}
+
+/*
+*Prints all solutions of enumeration stream in ASCII format, solutions are separated by empty line
+*Returns 1, if stream is damaged, else 0
+*/
+int printEnumerationStream(FILE * input){
+
+	unsigned char clueArray[32][32];
+	unsigned char record[4 * MAX_NUMBER_OF_ELEMENTS];
+	Rectangle rectangles[MAX_NUMBER_OF_ELEMENTS];
+	int numberOfRows, numberOfCols, totalNumbers;
+	if (readPuzzleRecord(input, clueArray, &numberOfRows, &numberOfCols, &totalNumbers) != 1){
+		printf("Nespravny vstup.\n");
+		return 1;
+	}
+	/* clues are in the same order as elements, from left top to right bottom */
+	int count = 0, numberOfSolutions = 0;
+	for (int i = 0; i < numberOfRows; i++)
+		for (int j = 0; j < numberOfCols; j++)
+			if (clueArray[i][j] != 0){
+				rectangles[count].row = i;
+				rectangles[count++].col = j;
+			}
+	size_t length;
+	while ((length = fread(record, 1, 4 * totalNumbers, input)) != 0){
+		/* stream can end only between records */
+		if (length != (size_t)(4 * totalNumbers)){
+			printf("Nespravny vstup.\n");
+			return 1;
+		}
+		for (int i = 0; i < totalNumbers; i++){
+			rectangles[i].top = record[4 * i];
+			rectangles[i].left = record[4 * i + 1];
+			rectangles[i].bottom = record[4 * i + 2];
+			rectangles[i].right = record[4 * i + 3];
+			/* stop at damaged record */
+			if (!rectangleValid(&rectangles[i], numberOfRows, numberOfCols) || rectangleArea(&rectangles[i]) != clueArray[rectangles[i].row][rectangles[i].col]){
+				printf("Nespravny vstup.\n");
+				return 1;
+			}
+		}
+		printf("Reseni %d:\n", ++numberOfSolutions);
+		printRectangles(rectangles, totalNumbers, numberOfRows, numberOfCols);
+		printf("\n");
+	}
+	return 0;
+}
+
+/*
+*Prints binary stream of puzzles, solutions or enumerated solutions in ASCII format, records are separated by empty line
+*Returns 1, if stream is damaged
+*/
+int convertBinaryToAscii(const char * inputName){
+
+	unsigned char clueArray[32][32];
+	Rectangle rectangles[MAX_NUMBER_OF_ELEMENTS];
+	int numberOfRows, numberOfCols, totalNumbers, verdict, state, damaged = 0;
+	unsigned long long count;
+	unsigned int hash;
+	FILE * input = strcmp(inputName, "-") == 0 ? stdin : fopen(inputName, "rb");
+	int kind = input ? readBinaryHeader(input) : 0;
+	if (!kind){
+		printf("Nespravny vstup.\n");
+		if (input && input != stdin) fclose(input);
+		return 1;
+	}
+	if (kind == 'P'){
+		while ((state = readPuzzleRecord(input, clueArray, &numberOfRows, &numberOfCols, &totalNumbers)) > 0 || state == -1){
+			if (state == 1) printPuzzle(clueArray, numberOfRows, numberOfCols);
+			else printf("Nespravny vstup.\n");
+			printf("\n");
+		}
+		damaged = state == -2;
+	} else if (kind == 'E') damaged = printEnumerationStream(input);
+	else {
+		while ((state = readSolutionRecord(input, &verdict, &count, &hash, &numberOfRows, &numberOfCols, rectangles, &totalNumbers)) == 1){
+			if (verdict == BINARY_ONE_SOLUTION){
+				printf("Jedno reseni:\n");
+				printRectangles(rectangles, totalNumbers, numberOfRows, numberOfCols);
+			}
+			else if (verdict == BINARY_MORE_SOLUTIONS) printf("Celkem reseni: %llu\n", count);
+			else if (verdict == BINARY_NO_SOLUTION) printf("Reseni neexistuje.\n");
+			else printf("Nespravny vstup.\n");
+			printf("\n");
+		}
+		damaged = state == -2;
+	}
+	/* enumeration stream reports damage itself */
+	if (damaged && kind != 'E') printf("Nespravny vstup.\n");
+	if (input != stdin) fclose(input);
+	return damaged;
+}
+
+/*
+*Solves every puzzle of binary stream and writes binary stream of solutions
+*/
+int solveBinaryStream(const char * inputName, const char * outputName){
+
+	unsigned char clueArray[32][32];
+	unsigned char resultArray[32][32];
+	unsigned char buffer[MAX_SOLUTION_RECORD_SIZE];
+	Rectangle rectangles[MAX_NUMBER_OF_ELEMENTS];
+	int numberOfRows, numberOfCols, totalNumbers, state;
+	BinaryWriter writer;
+	Session session;
+	FILE * input = strcmp(inputName, "-") == 0 ? stdin : fopen(inputName, "rb");
+	if (!input || readBinaryHeader(input) != 'P' || !openBinaryWriter(&writer, outputName, SOLUTION_MAGIC)){
+		printf("Nespravny vstup.\n");
+		if (input && input != stdin) fclose(input);
+		return 1;
+	}
+	while ((state = readPuzzleRecord(input, clueArray, &numberOfRows, &numberOfCols, &totalNumbers)) > 0 || state == -1){
+		if (state == -1){
+			writeBinaryRecord(&writer, buffer, encodeSolution(buffer, BINARY_WRONG_INPUT, 0, 0, 0, 0, NULL, 0));
+			continue;
+		}
+		createSession(&session, clueArray, numberOfRows, numberOfCols, totalNumbers);
+		long long results = sessionSolve(&session, resultArray, NULL);
+		int verdict = results > 1 ? BINARY_MORE_SOLUTIONS : results == 1 ? BINARY_ONE_SOLUTION : BINARY_NO_SOLUTION;
+		if (results == 1) resultToRectangles(resultArray, session.elements, session.totalNumbers, numberOfRows, numberOfCols, rectangles);
+		writeBinaryRecord(&writer, buffer, encodeSolution(buffer, verdict, results, puzzleHash(clueArray, numberOfRows, numberOfCols), numberOfRows, numberOfCols, rectangles, results == 1 ? totalNumbers : 0));
+		freeMemory(session.elements, session.totalNumbers);
+	}
+	closeBinaryWriter(&writer);
+	if (input != stdin) fclose(input);
+	/* solutions would not be aligned with puzzles after damaged record */
+	if (state == -2){
+		printf("Nespravny vstup.\n");
+		return 1;
+	}
+	return 0;
+}
+
+/*
+*Binary mode. Usage:
+*	-ab ascii binary	- convert ASCII puzzles into binary stream
+*	-ba binary			- print binary stream of puzzles or solutions in ASCII format
+*	-bs puzzles solutions	- solve binary stream of puzzles
+*Name "-" means stdin or stdout, index is written only for files
+*/
+int runBinaryMode(int argc, char * argv[]){
+
+	if (strcmp(argv[1], "-ab") == 0 && argc == 4) return convertAsciiToBinary(argv[2], argv[3]);
+	if (strcmp(argv[1], "-ba") == 0 && argc == 3) return convertBinaryToAscii(argv[2]);
+	if (strcmp(argv[1], "-bs") == 0 && argc == 4) return solveBinaryStream(argv[2], argv[3]);
+	printf("Nespravny vstup.\n");
+	return 1;
+}
+
+/*-----------------------------------------ENUMERATION-----------------------------------------*/
+
+/*
+*Enumeration stream has header with magic "SHKE" and version (4B), then puzzle record (same as in puzzle stream)
+*and then every solution as numberOfClues times {top, left, bottom, right} (1B each), clues are in the same order as in puzzle record.
+*All solution records have the same length, so solution i is on offset header + puzzle record + i * 4 * numberOfClues
+*/
+
+/*
+*Writes data into bounded buffer, buffer is written into its stream, when it is full
+*/
+void bufferWrite(OutputBuffer * output, unsigned char data[], int length){
+
+	if (output->length + length > OUTPUT_BUFFER_SIZE){
+		fwrite(output->data, 1, output->length, output->stream);
+		output->length = 0;
+	}
+	memcpy(output->data + output->length, data, length);
+	output->length += length;
+}
+
+/*
+*Writes rest of buffer into its stream
+*/
+void bufferFlush(OutputBuffer * output){
+
+	fwrite(output->data, 1, output->length, output->stream);
+	output->length = 0;
+	fflush(output->stream);
+}
+
+/*
+*Called by computeResults for every result. Writes rectangles of all elements, if result is not skipped by offset
+*/
+void writeEnumeratedResult(void * data, Element * elements, int options[], int numberOfOptions, long long result){
+
+	Enumeration * enumeration = (Enumeration*) data;
+	unsigned char record[4 * MAX_NUMBER_OF_ELEMENTS];
+	if (result <= enumeration->offset) return;
+	for (int i = 0; i < numberOfOptions; i++){
+		int elIndex = options[i] / ID_MULTIPLIER - 1;
+		int opIndex = options[i] % ID_MULTIPLIER - 1;
+		unsigned char * rectangle = record + 4 * elIndex;
+		rectangle[0] = rectangle[2] = elements[elIndex].row;
+		rectangle[1] = rectangle[3] = elements[elIndex].col;
+		for (int k = 0; k < (elements[elIndex].value * 2) - 2; k += 2){
+			unsigned char row = elements[elIndex].options[opIndex].arrayOfIndexes[k];
+			unsigned char col = elements[elIndex].options[opIndex].arrayOfIndexes[k + 1];
+			if (row < rectangle[0]) rectangle[0] = row;
+			if (col < rectangle[1]) rectangle[1] = col;
+			if (row > rectangle[2]) rectangle[2] = row;
+			if (col > rectangle[3]) rectangle[3] = col;
+		}
+	}
+	bufferWrite(enumeration->output, record, 4 * numberOfOptions);
+	enumeration->written++;
+}
+
+/*
+*Enumeration mode. Reads puzzle from stdin and writes every solution into enumeration stream on stdout, as soon as it is found.
+*Optional arguments are maximum number of written solutions (0 for all) and number of solutions skipped at the beginning,
+*so interrupted enumeration can be resumed. Number of written solutions is reported on stderr
+*/
+int runEnumerationMode(int argc, char * argv[]){
+
+	unsigned char mainArray[32][32];
+	unsigned char resultArray[32][32];
+	unsigned char header[BINARY_HEADER_SIZE];
+	unsigned char buffer[MAX_PUZZLE_RECORD_SIZE];
+	int numberOfRows = 0, numberOfCols = 0, totalNumbers = 0;
+	long long cap = 0;
+	static OutputBuffer output;
+	Enumeration enumeration = {&output, 0, 0};
+	Session session;
+
+	if (argc > 4 || (argc > 2 && (sscanf(argv[2], "%lld", &cap) != 1 || cap < 0))
+	|| (argc > 3 && (sscanf(argv[3], "%lld", &enumeration.offset) != 1 || enumeration.offset < 0))
+	/* search stops at cap + offset results, that must fit into long long */
+	|| cap > LLONG_MAX - enumeration.offset
+	|| !readInput(stdin, mainArray, &numberOfRows, &numberOfCols, &totalNumbers)){
+		printf("Nespravny vstup.\n");
+		return 1;
+	}
+	output.stream = stdout;
+	output.length = 0;
+	memcpy(header, ENUMERATION_MAGIC, 4);
+	writeLittleEndian(header + 4, BINARY_VERSION, 4);
+	bufferWrite(&output, header, BINARY_HEADER_SIZE);
+	bufferWrite(&output, buffer, encodePuzzle(buffer, mainArray, numberOfRows, numberOfCols));
+
+	SearchControl control = {0};
+	control.maxResults = cap > 0 ? cap + enumeration.offset : 0;
+	control.onResult = writeEnumeratedResult;
+	control.data = &enumeration;
+	createSession(&session, mainArray, numberOfRows, numberOfCols, totalNumbers);
+	sessionSolve(&session, resultArray, &control);
+	bufferFlush(&output);
+	fprintf(stderr, "Zapsano reseni: %lld\n", enumeration.written);
+
+	freeMemory(session.elements, session.totalNumbers);
+	return 0;
+}
+
+/*-----------------------------------------CUBE AND CONQUER-----------------------------------------*/
+
+/*
+*Cube file (one open subproblem) has header with magic "SHKC" and version (4B), then puzzle record (same as in puzzle stream)
+*and then for every element in order of clues: numberOfOptions (2B), placed option index + 1 or 0 (2B),
+*size of domain (2B) and indexes of options in domain (2B each). Domain of placed element is empty.
+*Options are recomputed from puzzle, numberOfOptions is used to check, that they are the same
+*/
+
+/*
+*Called by computeResults for every open branch at maxDepth. Writes branch into new cube file or only counts it,
+*if splitter has no directory
+*/
+void writeCube(void * data, Element * elements, int options[], int numberOfOptions){
+
+	Splitter * splitter = (Splitter*) data;
+	Session * session = splitter->session;
+	unsigned char buffer[MAX_PUZZLE_RECORD_SIZE];
+	int placedArr[MAX_NUMBER_OF_ELEMENTS] = {0};
+	char fileName[4096];
+	splitter->numberOfCubes++;
+	if (!splitter->directory || splitter->failed) return;
+
+	snprintf(fileName, sizeof(fileName), "%s/cube_%06d.bin", splitter->directory, splitter->numberOfCubes);
+	FILE * file = fopen(fileName, "wb");
+	if (!file){
+		splitter->failed = 1;
+		return;
+	}
+	for (int i = 0; i < numberOfOptions; i++) placedArr[options[i] / ID_MULTIPLIER - 1] = options[i] % ID_MULTIPLIER;
+	memcpy(buffer, CUBE_MAGIC, 4);
+	writeLittleEndian(buffer + 4, BINARY_VERSION, 4);
+	fwrite(buffer, 1, BINARY_HEADER_SIZE, file);
+	fwrite(buffer, 1, encodePuzzle(buffer, session->clueArray, session->numberOfRows, session->numberOfCols), file);
+	for (int i = 0; i < session->totalNumbers; i++){
+		int domainSize = 0;
+		if (!placedArr[i])
+			for (int j = 0; j < elements[i].numberOfOptions; j++) if (!elements[i].options[j].implacable) domainSize++;
+		writeLittleEndian(buffer, elements[i].numberOfOptions, 2);
+		writeLittleEndian(buffer + 2, placedArr[i], 2);
+		writeLittleEndian(buffer + 4, domainSize, 2);
+		fwrite(buffer, 1, 6, file);
+		for (int j = 0; j < elements[i].numberOfOptions && domainSize > 0; j++){
+			if (elements[i].options[j].implacable) continue;
+			writeLittleEndian(buffer, j, 2);
+			fwrite(buffer, 1, 2, file);
+		}
+	}
+	if (fclose(file) != 0) splitter->failed = 1;
+}
+
+/*
+*Reads cube file into new session. Placed options are marked and options out of domains are implacable
+*Ids of placed options are stored in options, their number in spot. Returns 0, if cube is wrong or its placed options overlap
+*/
+int readCube(FILE * file, Session * session, int options[], int * spot){
+
+	unsigned char clueArray[32][32];
+	unsigned char buffer[6];
+	int placedArr[MAX_NUMBER_OF_ELEMENTS];
+	int numberOfRows, numberOfCols, totalNumbers, ok = 1;
+	if (readBinaryHeader(file) != 'C' || readPuzzleRecord(file, clueArray, &numberOfRows, &numberOfCols, &totalNumbers) != 1) return 0;
+
+	createSession(session, clueArray, numberOfRows, numberOfCols, totalNumbers);
+	resetSessionState(session);
+	Element * elements = session->elements;
+	for (int i = 0; i < totalNumbers && ok; i++){
+		if (fread(buffer, 1, 6, file) != 6 || (int)readLittleEndian(buffer, 2) != elements[i].numberOfOptions){
+			ok = 0;
+			break;
+		}
+		placedArr[i] = readLittleEndian(buffer + 2, 2);
+		int domainSize = readLittleEndian(buffer + 4, 2);
+		if (placedArr[i] > elements[i].numberOfOptions || (placedArr[i] && domainSize)) ok = 0;
+		if (placedArr[i]){
+			elements[i].inUse = 1;
+			continue;
+		}
+		/* everything out of domain is implacable */
+		for (int j = 0; j < elements[i].numberOfOptions; j++) elements[i].options[j].implacable = 1;
+		elements[i].numberOfImplacableOptions = elements[i].numberOfOptions;
+		for (int k = 0; k < domainSize && ok; k++){
+			if (fread(buffer, 1, 2, file) != 2) ok = 0;
+			int index = readLittleEndian(buffer, 2);
+			if (!ok || index >= elements[i].numberOfOptions || !elements[i].options[index].implacable) ok = 0;
+			else {
+				elements[i].options[index].implacable = 0;
+				elements[i].numberOfImplacableOptions--;
+			}
+		}
+		for (int j = 0; j < elements[i].numberOfOptions; j++)
+			if (elements[i].options[j].implacable) elements[i].options[j].implacedBy = PREPROCESSOR_ID;
+	}
+	if (!ok){
+		freeMemory(session->elements, session->totalNumbers);
+		return 0;
+	}
+	*spot = 0;
+	for (int i = 0; i < totalNumbers; i++){
+		if (!placedArr[i]) continue;
+		options[(*spot)++] = elements[i].options[placedArr[i] - 1].id;
+		markImplacables(elements, i, placedArr[i] - 1);
+		/* markImplacables skips placed elements, so collisions between placed options are checked here */
+		Option * option = &elements[i].options[placedArr[i] - 1];
+		for (int k = 0; k < option->numberOfImplaces && ok; k += 2)
+			if (placedArr[option->implacesArr[k]] == option->implacesArr[k + 1] + 1) ok = 0;
+	}
+	if (!ok){
+		freeMemory(session->elements, session->totalNumbers);
+		return 0;
+	}
+	return 1;
+}
+
+/*
+*Writes result file, solution stream with one record. For more solutions, first of them is written as witness
+*/
+int writeResultFile(const char * fileName, long long results, unsigned char resultArray[][32], Session * session){
+
+	unsigned char buffer[MAX_SOLUTION_RECORD_SIZE];
+	Rectangle rectangles[MAX_NUMBER_OF_ELEMENTS];
+	BinaryWriter writer;
+	int verdict = results > 1 ? BINARY_MORE_SOLUTIONS : results == 1 ? BINARY_ONE_SOLUTION : BINARY_NO_SOLUTION;
+	if (!openBinaryWriter(&writer, fileName, SOLUTION_MAGIC)) return 0;
+	if (results > 0) resultToRectangles(resultArray, session->elements, session->totalNumbers, session->numberOfRows, session->numberOfCols, rectangles);
+	writeBinaryRecord(&writer, buffer, encodeSolution(buffer, verdict, results, puzzleHash(session->clueArray, session->numberOfRows, session->numberOfCols), session->numberOfRows, session->numberOfCols, rectangles, results > 0 ? session->totalNumbers : 0));
+	closeBinaryWriter(&writer);
+	return 1;
+}
+
+/*
+*Split mode. Reads puzzle from stdin and searches it to given depth (number of decisions) or to the smallest depth,
+*that has at least given number of open branches. Every open branch is written into its own cube file in directory,
+*solutions found above that depth are written into result file split.res in the same directory
+*/
+int runSplitMode(int argc, char * argv[]){
+
+	unsigned char mainArray[32][32];
+	unsigned char resultArray[32][32];
+	char fileName[4096];
+	int numberOfRows = 0, numberOfCols = 0, totalNumbers = 0, limit = 0;
+	int bySize = strcmp(argv[1], "-sf") == 0;
+	Session session;
+	Splitter splitter = {&session, NULL, 0, 0};
+	SearchControl control = {0};
+
+	if (argc != 4 || sscanf(argv[2], "%d", &limit) != 1 || limit < 1 || !readInput(stdin, mainArray, &numberOfRows, &numberOfCols, &totalNumbers)){
+		printf("Nespravny vstup.\n");
+		return 1;
+	}
+	createSession(&session, mainArray, numberOfRows, numberOfCols, totalNumbers);
+	control.onFrontier = writeCube;
+	control.data = &splitter;
+	control.maxDepth = limit;
+	if (bySize){
+		/* count open branches of deeper and deeper frontier, until there are enough of them or none */
+		for (control.maxDepth = 1; control.maxDepth < totalNumbers; control.maxDepth++){
+			splitter.numberOfCubes = 0;
+			sessionSolve(&session, resultArray, &control);
+			if (splitter.numberOfCubes == 0 || splitter.numberOfCubes >= limit) break;
+		}
+		splitter.numberOfCubes = 0;
+	}
+	splitter.directory = argv[3];
+	long long results = sessionSolve(&session, resultArray, &control);
+	snprintf(fileName, sizeof(fileName), "%s/split.res", argv[3]);
+	if (splitter.failed || !writeResultFile(fileName, results, resultArray, &session)){
+		printf("Nespravny vstup.\n");
+		freeMemory(session.elements, session.totalNumbers);
+		return 1;
+	}
+	fprintf(stderr, "Hloubka %d, podproblemu: %d, reseni nad hloubkou: %lld\n", control.maxDepth, splitter.numberOfCubes, results);
+
+	freeMemory(session.elements, session.totalNumbers);
+	return 0;
+}
+
+/*
+*Conquer mode. Solves one cube file and writes result file
+*/
+int runConquerMode(int argc, char * argv[]){
+
+	unsigned char resultArray[32][32];
+	int options[MAX_NUMBER_OF_ELEMENTS + 1];
+	int spot = 0;
+	Session session;
+	FILE * file = argc == 4 ? fopen(argv[2], "rb") : NULL;
+	if (!file || !readCube(file, &session, options, &spot)){
+		printf("Nespravny vstup.\n");
+		if (file) fclose(file);
+		return 1;
+	}
+	fclose(file);
+	long long results = sessionSearch(&session, options, spot, resultArray, NULL);
+	int ok = writeResultFile(argv[3], results, resultArray, &session);
+	if (!ok) printf("Nespravny vstup.\n");
+
+	freeMemory(session.elements, session.totalNumbers);
+	return !ok;
+}
+
+/*
+*Merge mode. Sums results of all result files and prints final result in the same format as main,
+*for more solutions one of them is printed too. All result files must belong to the same puzzle
+*/
+int runMergeMode(int argc, char * argv[]){
+
+	Rectangle rectangles[MAX_NUMBER_OF_ELEMENTS], witness[MAX_NUMBER_OF_ELEMENTS];
+	int verdict, numberOfRows, numberOfCols, numberOfRectangles, witnessRows = 0, witnessCols = 0, numberOfWitness = 0;
+	int firstRows = 0, firstCols = 0;
+	unsigned int hash, firstHash = 0;
+	unsigned long long count, total = 0;
+
+	for (int i = 2; i < argc; i++){
+		FILE * file = fopen(argv[i], "rb");
+		int ok = file && readBinaryHeader(file) == 'S' && readSolutionRecord(file, &verdict, &count, &hash, &numberOfRows, &numberOfCols, rectangles, &numberOfRectangles) == 1
+			&& verdict != BINARY_WRONG_INPUT;
+		if (ok && i == 2){
+			firstHash = hash;
+			firstRows = numberOfRows;
+			firstCols = numberOfCols;
+		}
+		/* result of another puzzle */
+		if (ok && (hash != firstHash || numberOfRows != firstRows || numberOfCols != firstCols)) ok = 0;
+		if (file) fclose(file);
+		if (!ok){
+			printf("Nespravny vstup.\n");
+			return 1;
+		}
+		total += count;
+		if (numberOfWitness == 0 && numberOfRectangles > 0){
+			memcpy(witness, rectangles, numberOfRectangles * sizeof(*witness));
+			numberOfWitness = numberOfRectangles;
+			witnessRows = numberOfRows;
+			witnessCols = numberOfCols;
+		}
+	}
+	if (argc < 3) printf("Nespravny vstup.\n");
+	else if (total == 0) printf("Reseni neexistuje.\n");
+	else if (total == 1){
+		printf("Jedno reseni:\n");
+		printRectangles(witness, numberOfWitness, witnessRows, witnessCols);
+	} else {
+		printf("Celkem reseni: %llu\n", total);
+		printf("Priklad reseni:\n");
+		printRectangles(witness, numberOfWitness, witnessRows, witnessCols);
+	}
+	return argc < 3;
+}
+
+/*-----------------------------------------PORTFOLIO-----------------------------------------*/
+
+/*
+*Returns 1, if some thread of portfolio already settled the query. Used as cancel check of search
+*/
+int portfolioSettled(void * data){
+
+	Portfolio * portfolio = (Portfolio*) data;
+	pthread_mutex_lock(&portfolio->mutex);
+	int settled = portfolio->winner != -1;
+	pthread_mutex_unlock(&portfolio->mutex);
+	return settled;
+}
+
+/*
+*One thread of portfolio. Searches for as many solutions as query needs with its own heuristic, until it settles the query
+*or other thread does. Randomized heuristic restarts with doubled limit of placed options, when it reaches the limit
+*/
+void * portfolioWorker(void * data){
+
+	PortfolioWorker * worker = (PortfolioWorker*) data;
+	Portfolio * portfolio = worker->portfolio;
+	SearchControl control = {0};
+	control.maxResults = portfolio->query;
+	control.heuristic = worker->heuristic;
+	control.randomState = 0x9E3779B97F4A7C15ULL;
+	control.cancelled = portfolioSettled;
+	control.data = portfolio;
+	if (worker->heuristic == HEURISTIC_RANDOM) control.maxNodes = PORTFOLIO_FIRST_RESTART;
+	createSession(&worker->session, portfolio->clueArray, portfolio->numberOfRows, portfolio->numberOfCols, portfolio->totalNumbers);
+
+	while (1){
+		control.nodes = 0;
+		worker->results = sessionSolve(&worker->session, worker->resultArray, &control);
+		worker->nodes += control.nodes;
+		if (portfolioSettled(portfolio)) return NULL;
+		if (control.maxNodes == 0 || control.nodes < control.maxNodes) break;
+		control.maxNodes *= 2;
+		worker->restarts++;
+	}
+	pthread_mutex_lock(&portfolio->mutex);
+	if (portfolio->winner == -1) portfolio->winner = worker->index;
+	pthread_mutex_unlock(&portfolio->mutex);
+	return NULL;
+}
+
+/*
+*Portfolio mode. Reads puzzle from stdin and runs one thread for every branching heuristic.
+*Query 1 asks, if puzzle has any solution, query 2 (default) asks, if it has none, one or more solutions.
+*The first thread, that answers the query, wins and the others are cancelled.
+*Prints the verdict, winning heuristic is printed to stderr
+*/
+int runPortfolioMode(int argc, char * argv[]){
+
+	const char * heuristicNames[NUMBER_OF_HEURISTICS] = {"vychozi", "nejmene moznosti", "nejvetsi hodnota", "nejvice kolizi", "nahodna"};
+	static Portfolio portfolio;
+	static PortfolioWorker workers[NUMBER_OF_HEURISTICS];
+	pthread_t threads[NUMBER_OF_HEURISTICS];
+
+	portfolio.query = 2;
+	if (argc > 3 || (argc == 3 && (sscanf(argv[2], "%d", &portfolio.query) != 1 || portfolio.query < 1 || portfolio.query > 2))
+	|| !readInput(stdin, portfolio.clueArray, &portfolio.numberOfRows, &portfolio.numberOfCols, &portfolio.totalNumbers)){
+		printf("Nespravny vstup.\n");
+		return 1;
+	}
+	portfolio.winner = -1;
+	pthread_mutex_init(&portfolio.mutex, NULL);
+	double start = currentTime();
+	for (int i = 0; i < NUMBER_OF_HEURISTICS; i++){
+		workers[i].portfolio = &portfolio;
+		workers[i].index = i;
+		workers[i].heuristic = i;
+		workers[i].nodes = 0;
+		workers[i].restarts = 0;
+		pthread_create(&threads[i], NULL, portfolioWorker, &workers[i]);
+	}
+	for (int i = 0; i < NUMBER_OF_HEURISTICS; i++) pthread_join(threads[i], NULL);
+	pthread_mutex_destroy(&portfolio.mutex);
+
+	PortfolioWorker * winner = &workers[portfolio.winner];
+	if (winner->results == 0) printf("Reseni neexistuje.\n");
+	else if (portfolio.query == 1){
+		printf("Reseni existuje:\n");
+		printBoard(winner->resultArray, winner->session.elements, winner->session.totalNumbers, portfolio.numberOfRows, portfolio.numberOfCols);
+	}
+	else if (winner->results == 1) printResult(winner->resultArray, winner->session.elements, winner->session.totalNumbers, portfolio.numberOfRows, portfolio.numberOfCols);
+	else printf("Reseni neni jednoznacne.\n");
+	fprintf(stderr, "Rozhodla heuristika %s za %.3f s (%lld umisteni, %d restartu)\n", heuristicNames[winner->heuristic], currentTime() - start, winner->nodes, winner->restarts);
+
+	for (int i = 0; i < NUMBER_OF_HEURISTICS; i++) freeMemory(workers[i].session.elements, workers[i].session.totalNumbers);
+	return 0;
+}
+
+/*-----------------------------------------MAIN-----------------------------------------*/
+
+
+
+int main(int argc, char * argv[]){
+	
+	if (argc > 1 && strcmp(argv[1], "-e") == 0) return runEditMode(argc, argv);
+	if (argc > 1 && strcmp(argv[1], "-g") == 0) return runGeneratorMode(argc, argv);
+	if (argc > 1 && strcmp(argv[1], "-l") == 0) return runEnumerationMode(argc, argv);
+	if (argc > 1 && (strcmp(argv[1], "-s") == 0 || strcmp(argv[1], "-sf") == 0)) return runSplitMode(argc, argv);
+	if (argc > 1 && strcmp(argv[1], "-c") == 0) return runConquerMode(argc, argv);
+	if (argc > 1 && strcmp(argv[1], "-m") == 0) return runMergeMode(argc, argv);
+	if (argc > 1 && strcmp(argv[1], "-p") == 0) return runPortfolioMode(argc, argv);
+	if (argc > 1 && (strcmp(argv[1], "-ab") == 0 || strcmp(argv[1], "-ba") == 0 || strcmp(argv[1], "-bs") == 0)) return runBinaryMode(argc, argv);
 
-int main(void){
-	
 	unsigned char mainArray[32][32];
 	int numberOfRows = 0, numberOfCols = 0, totalNumbers = 0;
 	int noPossibleSolution = 0;
-	int results = 0;
+	long long results = 0;
 	int alreadyComplete = 0;
 	printf("Zadejte puzzle:\n");
 	/* Assign input into main array, end program, if error occured while reading input */
-	if (!readInput(mainArray, &numberOfRows, &numberOfCols, &totalNumbers)){
+	if (!readInput(stdin, mainArray, &numberOfRows, &numberOfCols, &totalNumbers)){
 		printf("Nespravny vstup.\n");
 		return 1;
 	}
@@ -774,7 +2666,7 @@ int main(void){
 	/* If one and only solution was found, prints it. If it found, that it is impossible to fill the field, prints result */	
 	if (preProcessing(mainArray, elements, numberOfRows, numberOfCols, totalNumbers, &noPossibleSolution, &alreadyComplete) == 2){
 		/* Fill array of option of each element with indexes of other options, that are implaced with calling option */
-		fillImplacableArrays(mainArray, elements, totalNumbers, numberOfRows, numberOfCols);
+		fillImplacableArrays(elements, totalNumbers);
 		/* Find best fitting index of element, that will enter recursion as first */
 		int index = findIndexOfBiggestNotInUseElement(elements, totalNumbers);
 		
@@ -784,9 +2676,9 @@ int main(void){
 		/* This array is the one that will be printed, if there is only one correct result */
 		unsigned char resultArray[32][32];
 		/* Recursive backtracking of all correct results */
-		computeResults(mainArray, elements, totalNumbers, index, &results, options, spot, resultArray, numberOfRows, numberOfCols, alreadyComplete);
+		computeResults(mainArray, elements, totalNumbers, index, &results, options, spot, resultArray, numberOfRows, numberOfCols, alreadyComplete, NULL);
 		/* Print number of correct results, if there were more than 1 */
-		if (results > 1) printf("Celkem reseni: %d\n", results);
+		if (results > 1) printf("Celkem reseni: %lld\n", results);
 		/* Print correct result, if there was only one correct result */
 		else if (results == 1) printResult(resultArray, elements, totalNumbers, numberOfRows, numberOfCols);
 		/* Print, if no results are possible */